@@ -89,6 +89,37 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// calibration_unweighted
+Rcpp::List calibration_unweighted(const Rcpp::IntegerVector& actual, const Rcpp::NumericMatrix& response, int bins, std::string binning, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_calibration_unweighted(SEXP actualSEXP, SEXP responseSEXP, SEXP binsSEXP, SEXP binningSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< int >::type bins(binsSEXP);
+    Rcpp::traits::input_parameter< std::string >::type binning(binningSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(calibration_unweighted(actual, response, bins, binning, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
+// calibration_weighted
+Rcpp::List calibration_weighted(const Rcpp::IntegerVector& actual, const Rcpp::NumericMatrix& response, const Rcpp::NumericVector& w, int bins, std::string binning, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_calibration_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP binsSEXP, SEXP binningSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< int >::type bins(binsSEXP);
+    Rcpp::traits::input_parameter< std::string >::type binning(binningSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(calibration_weighted(actual, response, w, bins, binning, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
 // CohensKappa
 Rcpp::NumericVector CohensKappa(const Rcpp::IntegerVector& actual, const Rcpp::IntegerVector& predicted, const double& beta);
 RcppExport SEXP _SLmetrics_CohensKappa(SEXP actualSEXP, SEXP predictedSEXP, SEXP betaSEXP) {
@@ -153,6 +184,101 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// sketch_create
+Rcpp::List sketch_create(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<Rcpp::NumericVector> w, int bins, Rcpp::Nullable<Rcpp::NumericVector> breaks);
+RcppExport SEXP _SLmetrics_sketch_create(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP binsSEXP, SEXP breaksSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type w(wSEXP);
+    Rcpp::traits::input_parameter< int >::type bins(binsSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type breaks(breaksSEXP);
+    rcpp_result_gen = Rcpp::wrap(sketch_create(actual, response, w, bins, breaks));
+    return rcpp_result_gen;
+END_RCPP
+}
+// sketch_update
+Rcpp::List sketch_update(const Rcpp::List sketch, const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<Rcpp::NumericVector> w);
+RcppExport SEXP _SLmetrics_sketch_update(SEXP sketchSEXP, SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type sketch(sketchSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type w(wSEXP);
+    rcpp_result_gen = Rcpp::wrap(sketch_update(sketch, actual, response, w));
+    return rcpp_result_gen;
+END_RCPP
+}
+// sketch_merge
+Rcpp::List sketch_merge(const Rcpp::List x, const Rcpp::List y);
+RcppExport SEXP _SLmetrics_sketch_merge(SEXP xSEXP, SEXP ySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type y(ySEXP);
+    rcpp_result_gen = Rcpp::wrap(sketch_merge(x, y));
+    return rcpp_result_gen;
+END_RCPP
+}
+// sketch_auc
+Rcpp::NumericVector sketch_auc(const Rcpp::List sketch, Rcpp::Nullable<bool> micro, int curve, int method);
+RcppExport SEXP _SLmetrics_sketch_auc(SEXP sketchSEXP, SEXP microSEXP, SEXP curveSEXP, SEXP methodSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type sketch(sketchSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<bool> >::type micro(microSEXP);
+    Rcpp::traits::input_parameter< int >::type curve(curveSEXP);
+    Rcpp::traits::input_parameter< int >::type method(methodSEXP);
+    rcpp_result_gen = Rcpp::wrap(sketch_auc(sketch, micro, curve, method));
+    return rcpp_result_gen;
+END_RCPP
+}
+// sketch_curve
+Rcpp::DataFrame sketch_curve(const Rcpp::List sketch, int curve);
+RcppExport SEXP _SLmetrics_sketch_curve(SEXP sketchSEXP, SEXP curveSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type sketch(sketchSEXP);
+    Rcpp::traits::input_parameter< int >::type curve(curveSEXP);
+    rcpp_result_gen = Rcpp::wrap(sketch_curve(sketch, curve));
+    return rcpp_result_gen;
+END_RCPP
+}
+// delong_auc
+Rcpp::DataFrame delong_auc(const Rcpp::IntegerVector& actual, const Rcpp::NumericMatrix& response, double level, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_delong_auc(SEXP actualSEXP, SEXP responseSEXP, SEXP levelSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< double >::type level(levelSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(delong_auc(actual, response, level, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
+// delong_test
+Rcpp::List delong_test(const Rcpp::IntegerVector& actual, const Rcpp::NumericMatrix& response, int positive, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_delong_test(SEXP actualSEXP, SEXP responseSEXP, SEXP positiveSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< int >::type positive(positiveSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(delong_test(actual, response, positive, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
 // DiagnosticOddsRatio
 Rcpp::NumericVector DiagnosticOddsRatio(const Rcpp::IntegerVector& actual, const Rcpp::IntegerVector& predicted);
 RcppExport SEXP _SLmetrics_DiagnosticOddsRatio(SEXP actualSEXP, SEXP predictedSEXP) {
@@ -466,6 +592,33 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// roc_mauc
+double roc_mauc(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_roc_mauc(SEXP actualSEXP, SEXP responseSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_mauc(actual, response, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roc_mauc_weighted
+double roc_mauc_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_roc_mauc_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector >::type w(wSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_mauc_weighted(actual, response, w, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
 // JaccardIndex
 Rcpp::NumericVector JaccardIndex(const Rcpp::IntegerVector& actual, const Rcpp::IntegerVector& predicted, Rcpp::Nullable<bool> micro, const bool& na_rm);
 RcppExport SEXP _SLmetrics_JaccardIndex(SEXP actualSEXP, SEXP predictedSEXP, SEXP microSEXP, SEXP na_rmSEXP) {
@@ -769,6 +922,41 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// roc_pauc
+Rcpp::NumericVector roc_pauc(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, double lower, double upper, std::string focus, bool standardize, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_roc_pauc(SEXP actualSEXP, SEXP responseSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP focusSEXP, SEXP standardizeSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< double >::type lower(lowerSEXP);
+    Rcpp::traits::input_parameter< double >::type upper(upperSEXP);
+    Rcpp::traits::input_parameter< std::string >::type focus(focusSEXP);
+    Rcpp::traits::input_parameter< bool >::type standardize(standardizeSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_pauc(actual, response, lower, upper, focus, standardize, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roc_pauc_weighted
+Rcpp::NumericVector roc_pauc_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, double lower, double upper, std::string focus, bool standardize, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_roc_pauc_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP lowerSEXP, SEXP upperSEXP, SEXP focusSEXP, SEXP standardizeSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector >::type w(wSEXP);
+    Rcpp::traits::input_parameter< double >::type lower(lowerSEXP);
+    Rcpp::traits::input_parameter< double >::type upper(upperSEXP);
+    Rcpp::traits::input_parameter< std::string >::type focus(focusSEXP);
+    Rcpp::traits::input_parameter< bool >::type standardize(standardizeSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_pauc_weighted(actual, response, w, lower, upper, focus, standardize, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
 // PositiveLikelihoodRatio
 Rcpp::NumericVector PositiveLikelihoodRatio(const Rcpp::IntegerVector& actual, const Rcpp::IntegerVector& predicted);
 RcppExport SEXP _SLmetrics_PositiveLikelihoodRatio(SEXP actualSEXP, SEXP predictedSEXP) {
@@ -890,8 +1078,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // precision_recall_curve
-Rcpp::DataFrame precision_recall_curve(const Rcpp::IntegerVector& actual, const Rcpp::NumericMatrix& response, Rcpp::Nullable<Rcpp::NumericMatrix> thresholds, bool presorted);
-RcppExport SEXP _SLmetrics_precision_recall_curve(SEXP actualSEXP, SEXP responseSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP) {
+Rcpp::DataFrame precision_recall_curve(const Rcpp::IntegerVector& actual, const Rcpp::NumericMatrix& response, Rcpp::Nullable<Rcpp::NumericMatrix> thresholds, bool presorted, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_precision_recall_curve(SEXP actualSEXP, SEXP responseSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP, SEXP rankingSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -899,13 +1087,14 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type response(responseSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericMatrix> >::type thresholds(thresholdsSEXP);
     Rcpp::traits::input_parameter< bool >::type presorted(presortedSEXP);
-    rcpp_result_gen = Rcpp::wrap(precision_recall_curve(actual, response, thresholds, presorted));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(precision_recall_curve(actual, response, thresholds, presorted, ranking));
     return rcpp_result_gen;
 END_RCPP
 }
 // weighted_precision_recall_curve
-Rcpp::DataFrame weighted_precision_recall_curve(const Rcpp::IntegerVector& actual, const Rcpp::NumericMatrix& response, const Rcpp::NumericVector& w, Rcpp::Nullable<Rcpp::NumericVector> thresholds, bool presorted);
-RcppExport SEXP _SLmetrics_weighted_precision_recall_curve(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP) {
+Rcpp::DataFrame weighted_precision_recall_curve(const Rcpp::IntegerVector& actual, const Rcpp::NumericMatrix& response, const Rcpp::NumericVector& w, Rcpp::Nullable<Rcpp::NumericVector> thresholds, bool presorted, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_weighted_precision_recall_curve(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP, SEXP rankingSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -914,13 +1103,14 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type thresholds(thresholdsSEXP);
     Rcpp::traits::input_parameter< bool >::type presorted(presortedSEXP);
-    rcpp_result_gen = Rcpp::wrap(weighted_precision_recall_curve(actual, response, w, thresholds, presorted));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_precision_recall_curve(actual, response, w, thresholds, presorted, ranking));
     return rcpp_result_gen;
 END_RCPP
 }
 // precision_recall_auc
-Rcpp::NumericVector precision_recall_auc(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<bool> micro, int method);
-RcppExport SEXP _SLmetrics_precision_recall_auc(SEXP actualSEXP, SEXP responseSEXP, SEXP microSEXP, SEXP methodSEXP) {
+Rcpp::NumericVector precision_recall_auc(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<bool> micro, int method, Rcpp::Nullable<Rcpp::RObject> ranking, Rcpp::Nullable<int> bins);
+RcppExport SEXP _SLmetrics_precision_recall_auc(SEXP actualSEXP, SEXP responseSEXP, SEXP microSEXP, SEXP methodSEXP, SEXP rankingSEXP, SEXP binsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -928,13 +1118,15 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<bool> >::type micro(microSEXP);
     Rcpp::traits::input_parameter< int >::type method(methodSEXP);
-    rcpp_result_gen = Rcpp::wrap(precision_recall_auc(actual, response, micro, method));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<int> >::type bins(binsSEXP);
+    rcpp_result_gen = Rcpp::wrap(precision_recall_auc(actual, response, micro, method, ranking, bins));
     return rcpp_result_gen;
 END_RCPP
 }
 // precision_recall_auc_weighted
-Rcpp::NumericVector precision_recall_auc_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<bool> micro, int method);
-RcppExport SEXP _SLmetrics_precision_recall_auc_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP microSEXP, SEXP methodSEXP) {
+Rcpp::NumericVector precision_recall_auc_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<bool> micro, int method, Rcpp::Nullable<Rcpp::RObject> ranking, Rcpp::Nullable<int> bins);
+RcppExport SEXP _SLmetrics_precision_recall_auc_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP microSEXP, SEXP methodSEXP, SEXP rankingSEXP, SEXP binsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -943,7 +1135,9 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericVector >::type w(wSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<bool> >::type micro(microSEXP);
     Rcpp::traits::input_parameter< int >::type method(methodSEXP);
-    rcpp_result_gen = Rcpp::wrap(precision_recall_auc_weighted(actual, response, w, micro, method));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<int> >::type bins(binsSEXP);
+    rcpp_result_gen = Rcpp::wrap(precision_recall_auc_weighted(actual, response, w, micro, method, ranking, bins));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1074,8 +1268,8 @@ BEGIN_RCPP
 END_RCPP
 }
 // roc_curve_unweighted
-Rcpp::DataFrame roc_curve_unweighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<Rcpp::NumericVector> thresholds, bool presorted);
-RcppExport SEXP _SLmetrics_roc_curve_unweighted(SEXP actualSEXP, SEXP responseSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP) {
+Rcpp::DataFrame roc_curve_unweighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<Rcpp::NumericVector> thresholds, bool presorted, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_roc_curve_unweighted(SEXP actualSEXP, SEXP responseSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP, SEXP rankingSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -1083,13 +1277,14 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type thresholds(thresholdsSEXP);
     Rcpp::traits::input_parameter< bool >::type presorted(presortedSEXP);
-    rcpp_result_gen = Rcpp::wrap(roc_curve_unweighted(actual, response, thresholds, presorted));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_curve_unweighted(actual, response, thresholds, presorted, ranking));
     return rcpp_result_gen;
 END_RCPP
 }
 // roc_curve_weighted
-Rcpp::DataFrame roc_curve_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<Rcpp::NumericVector> thresholds, bool presorted);
-RcppExport SEXP _SLmetrics_roc_curve_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP) {
+Rcpp::DataFrame roc_curve_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<Rcpp::NumericVector> thresholds, bool presorted, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_roc_curve_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP, SEXP rankingSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -1098,13 +1293,72 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericVector >::type w(wSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type thresholds(thresholdsSEXP);
     Rcpp::traits::input_parameter< bool >::type presorted(presortedSEXP);
-    rcpp_result_gen = Rcpp::wrap(roc_curve_weighted(actual, response, w, thresholds, presorted));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_curve_weighted(actual, response, w, thresholds, presorted, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
+// gain_curve_unweighted
+Rcpp::DataFrame gain_curve_unweighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<Rcpp::NumericVector> thresholds, bool presorted, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_gain_curve_unweighted(SEXP actualSEXP, SEXP responseSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type thresholds(thresholdsSEXP);
+    Rcpp::traits::input_parameter< bool >::type presorted(presortedSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(gain_curve_unweighted(actual, response, thresholds, presorted, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
+// gain_curve_weighted
+Rcpp::DataFrame gain_curve_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<Rcpp::NumericVector> thresholds, bool presorted, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_gain_curve_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP thresholdsSEXP, SEXP presortedSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector >::type w(wSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type thresholds(thresholdsSEXP);
+    Rcpp::traits::input_parameter< bool >::type presorted(presortedSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(gain_curve_weighted(actual, response, w, thresholds, presorted, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roc_ks
+Rcpp::NumericVector roc_ks(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_roc_ks(SEXP actualSEXP, SEXP responseSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_ks(actual, response, ranking));
+    return rcpp_result_gen;
+END_RCPP
+}
+// roc_ks_weighted
+Rcpp::NumericVector roc_ks_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<Rcpp::RObject> ranking);
+RcppExport SEXP _SLmetrics_roc_ks_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP rankingSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::IntegerVector >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector >::type w(wSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_ks_weighted(actual, response, w, ranking));
     return rcpp_result_gen;
 END_RCPP
 }
 // roc_auc
-Rcpp::NumericVector roc_auc(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<bool> micro, int method);
-RcppExport SEXP _SLmetrics_roc_auc(SEXP actualSEXP, SEXP responseSEXP, SEXP microSEXP, SEXP methodSEXP) {
+Rcpp::NumericVector roc_auc(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, Rcpp::Nullable<bool> micro, int method, Rcpp::Nullable<Rcpp::RObject> ranking, Rcpp::Nullable<int> bins);
+RcppExport SEXP _SLmetrics_roc_auc(SEXP actualSEXP, SEXP responseSEXP, SEXP microSEXP, SEXP methodSEXP, SEXP rankingSEXP, SEXP binsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -1112,13 +1366,15 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericMatrix >::type response(responseSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<bool> >::type micro(microSEXP);
     Rcpp::traits::input_parameter< int >::type method(methodSEXP);
-    rcpp_result_gen = Rcpp::wrap(roc_auc(actual, response, micro, method));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<int> >::type bins(binsSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_auc(actual, response, micro, method, ranking, bins));
     return rcpp_result_gen;
 END_RCPP
 }
 // roc_auc_weighted
-Rcpp::NumericVector roc_auc_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<bool> micro, int method);
-RcppExport SEXP _SLmetrics_roc_auc_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP microSEXP, SEXP methodSEXP) {
+Rcpp::NumericVector roc_auc_weighted(const Rcpp::IntegerVector actual, const Rcpp::NumericMatrix response, const Rcpp::NumericVector w, Rcpp::Nullable<bool> micro, int method, Rcpp::Nullable<Rcpp::RObject> ranking, Rcpp::Nullable<int> bins);
+RcppExport SEXP _SLmetrics_roc_auc_weighted(SEXP actualSEXP, SEXP responseSEXP, SEXP wSEXP, SEXP microSEXP, SEXP methodSEXP, SEXP rankingSEXP, SEXP binsSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
@@ -1127,7 +1383,9 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericVector >::type w(wSEXP);
     Rcpp::traits::input_parameter< Rcpp::Nullable<bool> >::type micro(microSEXP);
     Rcpp::traits::input_parameter< int >::type method(methodSEXP);
-    rcpp_result_gen = Rcpp::wrap(roc_auc_weighted(actual, response, w, micro, method));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::RObject> >::type ranking(rankingSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<int> >::type bins(binsSEXP);
+    rcpp_result_gen = Rcpp::wrap(roc_auc_weighted(actual, response, w, micro, method, ranking, bins));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1320,6 +1578,60 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// accumulator_create
+Rcpp::List accumulator_create(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, Rcpp::Nullable<Rcpp::NumericVector> w, double delta);
+RcppExport SEXP _SLmetrics_accumulator_create(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP deltaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type w(wSEXP);
+    Rcpp::traits::input_parameter< double >::type delta(deltaSEXP);
+    rcpp_result_gen = Rcpp::wrap(accumulator_create(actual, predicted, w, delta));
+    return rcpp_result_gen;
+END_RCPP
+}
+// accumulator_update
+Rcpp::List accumulator_update(const Rcpp::List accumulator, const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, Rcpp::Nullable<Rcpp::NumericVector> w);
+RcppExport SEXP _SLmetrics_accumulator_update(SEXP accumulatorSEXP, SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type accumulator(accumulatorSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type w(wSEXP);
+    rcpp_result_gen = Rcpp::wrap(accumulator_update(accumulator, actual, predicted, w));
+    return rcpp_result_gen;
+END_RCPP
+}
+// accumulator_merge
+Rcpp::List accumulator_merge(const Rcpp::List x, const Rcpp::List y);
+RcppExport SEXP _SLmetrics_accumulator_merge(SEXP xSEXP, SEXP ySEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::List >::type y(ySEXP);
+    rcpp_result_gen = Rcpp::wrap(accumulator_merge(x, y));
+    return rcpp_result_gen;
+END_RCPP
+}
+// accumulator_value
+Rcpp::NumericVector accumulator_value(const Rcpp::List accumulator, const Rcpp::CharacterVector& measures, double k, bool correction);
+RcppExport SEXP _SLmetrics_accumulator_value(SEXP accumulatorSEXP, SEXP measuresSEXP, SEXP kSEXP, SEXP correctionSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::List >::type accumulator(accumulatorSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type measures(measuresSEXP);
+    Rcpp::traits::input_parameter< double >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type correction(correctionSEXP);
+    rcpp_result_gen = Rcpp::wrap(accumulator_value(accumulator, measures, k, correction));
+    return rcpp_result_gen;
+END_RCPP
+}
 // rsq
 double rsq(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, double k);
 RcppExport SEXP _SLmetrics_rsq(SEXP actualSEXP, SEXP predictedSEXP, SEXP kSEXP) {
@@ -1501,22 +1813,411 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// metrics
+Rcpp::NumericVector metrics(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::CharacterVector& measures, double delta, double k, bool correction, Rcpp::Nullable<Rcpp::IntegerVector> group);
+RcppExport SEXP _SLmetrics_metrics(SEXP actualSEXP, SEXP predictedSEXP, SEXP measuresSEXP, SEXP deltaSEXP, SEXP kSEXP, SEXP correctionSEXP, SEXP groupSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type measures(measuresSEXP);
+    Rcpp::traits::input_parameter< double >::type delta(deltaSEXP);
+    Rcpp::traits::input_parameter< double >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type correction(correctionSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::IntegerVector> >::type group(groupSEXP);
+    rcpp_result_gen = Rcpp::wrap(metrics(actual, predicted, measures, delta, k, correction, group));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_metrics
+Rcpp::NumericVector weighted_metrics(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w, const Rcpp::CharacterVector& measures, double delta, double k, bool correction, Rcpp::Nullable<Rcpp::IntegerVector> group);
+RcppExport SEXP _SLmetrics_weighted_metrics(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP measuresSEXP, SEXP deltaSEXP, SEXP kSEXP, SEXP correctionSEXP, SEXP groupSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type measures(measuresSEXP);
+    Rcpp::traits::input_parameter< double >::type delta(deltaSEXP);
+    Rcpp::traits::input_parameter< double >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type correction(correctionSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::IntegerVector> >::type group(groupSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_metrics(actual, predicted, w, measures, delta, k, correction, group));
+    return rcpp_result_gen;
+END_RCPP
+}
+// mse_matrix
+Rcpp::NumericVector mse_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_mse_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(mse_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_mse_matrix
+Rcpp::NumericVector weighted_mse_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_mse_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_mse_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rmse_matrix
+Rcpp::NumericVector rmse_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_rmse_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(rmse_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_rmse_matrix
+Rcpp::NumericVector weighted_rmse_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_rmse_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_rmse_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// mae_matrix
+Rcpp::NumericVector mae_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_mae_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(mae_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_mae_matrix
+Rcpp::NumericVector weighted_mae_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_mae_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_mae_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// mape_matrix
+Rcpp::NumericVector mape_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_mape_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(mape_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_mape_matrix
+Rcpp::NumericVector weighted_mape_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_mape_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_mape_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// smape_matrix
+Rcpp::NumericVector smape_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_smape_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(smape_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_smape_matrix
+Rcpp::NumericVector weighted_smape_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_smape_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_smape_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// mpe_matrix
+Rcpp::NumericVector mpe_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_mpe_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(mpe_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_mpe_matrix
+Rcpp::NumericVector weighted_mpe_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_mpe_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_mpe_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rmsle_matrix
+Rcpp::NumericVector rmsle_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_rmsle_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(rmsle_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_rmsle_matrix
+Rcpp::NumericVector weighted_rmsle_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_rmsle_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_rmsle_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rsq_matrix
+Rcpp::NumericVector rsq_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, double k, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_rsq_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP kSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< double >::type k(kSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(rsq_matrix(actual, predicted, k, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_rsq_matrix
+Rcpp::NumericVector weighted_rsq_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, double k, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_rsq_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP kSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< double >::type k(kSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_rsq_matrix(actual, predicted, w, k, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rae_matrix
+Rcpp::NumericVector rae_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_rae_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(rae_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_rae_matrix
+Rcpp::NumericVector weighted_rae_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_rae_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_rae_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rrse_matrix
+Rcpp::NumericVector rrse_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_rrse_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(rrse_matrix(actual, predicted, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_rrse_matrix
+Rcpp::NumericVector weighted_rrse_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_rrse_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_rrse_matrix(actual, predicted, w, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// huberloss_matrix
+Rcpp::NumericVector huberloss_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, double delta, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_huberloss_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP deltaSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< double >::type delta(deltaSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(huberloss_matrix(actual, predicted, delta, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_huberloss_matrix
+Rcpp::NumericVector weighted_huberloss_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, double delta, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_huberloss_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP deltaSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< double >::type delta(deltaSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_huberloss_matrix(actual, predicted, w, delta, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ccc_matrix
+Rcpp::NumericVector ccc_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, bool correction, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_ccc_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP correctionSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< bool >::type correction(correctionSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(ccc_matrix(actual, predicted, correction, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_ccc_matrix
+Rcpp::NumericVector weighted_ccc_matrix(const Rcpp::NumericMatrix& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, bool correction, std::string multioutput, Rcpp::Nullable<Rcpp::NumericVector> output_weights);
+RcppExport SEXP _SLmetrics_weighted_ccc_matrix(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP correctionSEXP, SEXP multioutputSEXP, SEXP output_weightsSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< bool >::type correction(correctionSEXP);
+    Rcpp::traits::input_parameter< std::string >::type multioutput(multioutputSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type output_weights(output_weightsSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_ccc_matrix(actual, predicted, w, correction, multioutput, output_weights));
+    return rcpp_result_gen;
+END_RCPP
+}
 // pinball
-double pinball(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, double alpha, bool deviance);
+Rcpp::NumericVector pinball(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& alpha, bool deviance);
 RcppExport SEXP _SLmetrics_pinball(SEXP actualSEXP, SEXP predictedSEXP, SEXP alphaSEXP, SEXP devianceSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
     Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
-    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type alpha(alphaSEXP);
     Rcpp::traits::input_parameter< bool >::type deviance(devianceSEXP);
     rcpp_result_gen = Rcpp::wrap(pinball(actual, predicted, alpha, deviance));
     return rcpp_result_gen;
 END_RCPP
 }
 // weighted_pinball
-double weighted_pinball(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w, double alpha, bool deviance);
+Rcpp::NumericVector weighted_pinball(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w, const Rcpp::NumericVector& alpha, bool deviance);
 RcppExport SEXP _SLmetrics_weighted_pinball(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP alphaSEXP, SEXP devianceSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
@@ -1524,12 +2225,39 @@ BEGIN_RCPP
     Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
     Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
-    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type alpha(alphaSEXP);
     Rcpp::traits::input_parameter< bool >::type deviance(devianceSEXP);
     rcpp_result_gen = Rcpp::wrap(weighted_pinball(actual, predicted, w, alpha, deviance));
     return rcpp_result_gen;
 END_RCPP
 }
+// interval_score
+Rcpp::DataFrame interval_score(const Rcpp::NumericVector& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& alpha);
+RcppExport SEXP _SLmetrics_interval_score(SEXP actualSEXP, SEXP predictedSEXP, SEXP alphaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type alpha(alphaSEXP);
+    rcpp_result_gen = Rcpp::wrap(interval_score(actual, predicted, alpha));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_interval_score
+Rcpp::DataFrame weighted_interval_score(const Rcpp::NumericVector& actual, const Rcpp::NumericMatrix& predicted, const Rcpp::NumericVector& w, const Rcpp::NumericVector& alpha);
+RcppExport SEXP _SLmetrics_weighted_interval_score(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP alphaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type alpha(alphaSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_interval_score(actual, predicted, w, alpha));
+    return rcpp_result_gen;
+END_RCPP
+}
 // rae
 double rae(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted);
 RcppExport SEXP _SLmetrics_rae(SEXP actualSEXP, SEXP predictedSEXP) {
@@ -1582,6 +2310,149 @@ BEGIN_RCPP
     return rcpp_result_gen;
 END_RCPP
 }
+// medae
+double medae(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted);
+RcppExport SEXP _SLmetrics_medae(SEXP actualSEXP, SEXP predictedSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    rcpp_result_gen = Rcpp::wrap(medae(actual, predicted));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_medae
+double weighted_medae(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w);
+RcppExport SEXP _SLmetrics_weighted_medae(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_medae(actual, predicted, w));
+    return rcpp_result_gen;
+END_RCPP
+}
+// mdape
+double mdape(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted);
+RcppExport SEXP _SLmetrics_mdape(SEXP actualSEXP, SEXP predictedSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    rcpp_result_gen = Rcpp::wrap(mdape(actual, predicted));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_mdape
+double weighted_mdape(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w);
+RcppExport SEXP _SLmetrics_weighted_mdape(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_mdape(actual, predicted, w));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ae_quantile
+Rcpp::NumericVector ae_quantile(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& alpha);
+RcppExport SEXP _SLmetrics_ae_quantile(SEXP actualSEXP, SEXP predictedSEXP, SEXP alphaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type alpha(alphaSEXP);
+    rcpp_result_gen = Rcpp::wrap(ae_quantile(actual, predicted, alpha));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_ae_quantile
+Rcpp::NumericVector weighted_ae_quantile(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w, const Rcpp::NumericVector& alpha);
+RcppExport SEXP _SLmetrics_weighted_ae_quantile(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP alphaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type alpha(alphaSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_ae_quantile(actual, predicted, w, alpha));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ae_cvar
+double ae_cvar(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, double alpha);
+RcppExport SEXP _SLmetrics_ae_cvar(SEXP actualSEXP, SEXP predictedSEXP, SEXP alphaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    rcpp_result_gen = Rcpp::wrap(ae_cvar(actual, predicted, alpha));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_ae_cvar
+double weighted_ae_cvar(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w, double alpha);
+RcppExport SEXP _SLmetrics_weighted_ae_cvar(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP alphaSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_ae_cvar(actual, predicted, w, alpha));
+    return rcpp_result_gen;
+END_RCPP
+}
+// rolling
+Rcpp::NumericMatrix rolling(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, int window, const Rcpp::CharacterVector& measures, std::string type, double alpha, double delta, double k, bool correction);
+RcppExport SEXP _SLmetrics_rolling(SEXP actualSEXP, SEXP predictedSEXP, SEXP windowSEXP, SEXP measuresSEXP, SEXP typeSEXP, SEXP alphaSEXP, SEXP deltaSEXP, SEXP kSEXP, SEXP correctionSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< int >::type window(windowSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type measures(measuresSEXP);
+    Rcpp::traits::input_parameter< std::string >::type type(typeSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< double >::type delta(deltaSEXP);
+    Rcpp::traits::input_parameter< double >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type correction(correctionSEXP);
+    rcpp_result_gen = Rcpp::wrap(rolling(actual, predicted, window, measures, type, alpha, delta, k, correction));
+    return rcpp_result_gen;
+END_RCPP
+}
+// weighted_rolling
+Rcpp::NumericMatrix weighted_rolling(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w, int window, const Rcpp::CharacterVector& measures, std::string type, double alpha, double delta, double k, bool correction);
+RcppExport SEXP _SLmetrics_weighted_rolling(SEXP actualSEXP, SEXP predictedSEXP, SEXP wSEXP, SEXP windowSEXP, SEXP measuresSEXP, SEXP typeSEXP, SEXP alphaSEXP, SEXP deltaSEXP, SEXP kSEXP, SEXP correctionSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type predicted(predictedSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericVector& >::type w(wSEXP);
+    Rcpp::traits::input_parameter< int >::type window(windowSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::CharacterVector& >::type measures(measuresSEXP);
+    Rcpp::traits::input_parameter< std::string >::type type(typeSEXP);
+    Rcpp::traits::input_parameter< double >::type alpha(alphaSEXP);
+    Rcpp::traits::input_parameter< double >::type delta(deltaSEXP);
+    Rcpp::traits::input_parameter< double >::type k(kSEXP);
+    Rcpp::traits::input_parameter< bool >::type correction(correctionSEXP);
+    rcpp_result_gen = Rcpp::wrap(weighted_rolling(actual, predicted, w, window, measures, type, alpha, delta, k, correction));
+    return rcpp_result_gen;
+END_RCPP
+}
 // rmse
 double rmse(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted);
 RcppExport SEXP _SLmetrics_rmse(SEXP actualSEXP, SEXP predictedSEXP) {
@@ -1778,26 +2649,62 @@ BEGIN_RCPP
 END_RCPP
 }
 // sort_matrix
-Rcpp::NumericMatrix sort_matrix(Rcpp::NumericMatrix x, bool decreasing);
-RcppExport SEXP _SLmetrics_sort_matrix(SEXP xSEXP, SEXP decreasingSEXP) {
+Rcpp::NumericMatrix sort_matrix(const Rcpp::NumericMatrix& x, bool decreasing, Rcpp::Nullable<Rcpp::NumericMatrix> out);
+RcppExport SEXP _SLmetrics_sort_matrix(SEXP xSEXP, SEXP decreasingSEXP, SEXP outSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type x(xSEXP);
     Rcpp::traits::input_parameter< bool >::type decreasing(decreasingSEXP);
-    rcpp_result_gen = Rcpp::wrap(sort_matrix(x, decreasing));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericMatrix> >::type out(outSEXP);
+    rcpp_result_gen = Rcpp::wrap(sort_matrix(x, decreasing, out));
     return rcpp_result_gen;
 END_RCPP
 }
 // order_matrix
-Rcpp::IntegerMatrix order_matrix(Rcpp::NumericMatrix x, bool decreasing);
-RcppExport SEXP _SLmetrics_order_matrix(SEXP xSEXP, SEXP decreasingSEXP) {
+Rcpp::IntegerMatrix order_matrix(const Rcpp::NumericMatrix& x, bool decreasing, Rcpp::Nullable<Rcpp::IntegerMatrix> out);
+RcppExport SEXP _SLmetrics_order_matrix(SEXP xSEXP, SEXP decreasingSEXP, SEXP outSEXP) {
 BEGIN_RCPP
     Rcpp::RObject rcpp_result_gen;
     Rcpp::RNGScope rcpp_rngScope_gen;
-    Rcpp::traits::input_parameter< Rcpp::NumericMatrix >::type x(xSEXP);
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type x(xSEXP);
     Rcpp::traits::input_parameter< bool >::type decreasing(decreasingSEXP);
-    rcpp_result_gen = Rcpp::wrap(order_matrix(x, decreasing));
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::IntegerMatrix> >::type out(outSEXP);
+    rcpp_result_gen = Rcpp::wrap(order_matrix(x, decreasing, out));
+    return rcpp_result_gen;
+END_RCPP
+}
+// ranking_matrix
+Rcpp::List ranking_matrix(const Rcpp::NumericMatrix& response, Rcpp::Nullable<Rcpp::IntegerVector> actual, Rcpp::Nullable<Rcpp::NumericVector> w);
+RcppExport SEXP _SLmetrics_ranking_matrix(SEXP responseSEXP, SEXP actualSEXP, SEXP wSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< const Rcpp::NumericMatrix& >::type response(responseSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::IntegerVector> >::type actual(actualSEXP);
+    Rcpp::traits::input_parameter< Rcpp::Nullable<Rcpp::NumericVector> >::type w(wSEXP);
+    rcpp_result_gen = Rcpp::wrap(ranking_matrix(response, actual, w));
+    return rcpp_result_gen;
+END_RCPP
+}
+// simd_isa
+std::string simd_isa();
+RcppExport SEXP _SLmetrics_simd_isa() {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    rcpp_result_gen = Rcpp::wrap(simd_isa());
+    return rcpp_result_gen;
+END_RCPP
+}
+// use_simd
+std::string use_simd(bool value);
+RcppExport SEXP _SLmetrics_use_simd(SEXP valueSEXP) {
+BEGIN_RCPP
+    Rcpp::RObject rcpp_result_gen;
+    Rcpp::RNGScope rcpp_rngScope_gen;
+    Rcpp::traits::input_parameter< bool >::type value(valueSEXP);
+    rcpp_result_gen = Rcpp::wrap(use_simd(value));
     return rcpp_result_gen;
 END_RCPP
 }
@@ -1809,11 +2716,20 @@ static const R_CallMethodDef CallEntries[] = {
     {"_SLmetrics_BalancedAccuracy", (DL_FUNC) &_SLmetrics_BalancedAccuracy, 4},
     {"_SLmetrics_weighted_BalancedAccuracy", (DL_FUNC) &_SLmetrics_weighted_BalancedAccuracy, 5},
     {"_SLmetrics_cmatrix_BalancedAccuracy", (DL_FUNC) &_SLmetrics_cmatrix_BalancedAccuracy, 3},
+    {"_SLmetrics_calibration_unweighted", (DL_FUNC) &_SLmetrics_calibration_unweighted, 5},
+    {"_SLmetrics_calibration_weighted", (DL_FUNC) &_SLmetrics_calibration_weighted, 6},
     {"_SLmetrics_CohensKappa", (DL_FUNC) &_SLmetrics_CohensKappa, 3},
     {"_SLmetrics_weighted_CohensKappa", (DL_FUNC) &_SLmetrics_weighted_CohensKappa, 4},
     {"_SLmetrics_cmatrix_CohensKappa", (DL_FUNC) &_SLmetrics_cmatrix_CohensKappa, 2},
     {"_SLmetrics_UnweightedConfusionMatrix", (DL_FUNC) &_SLmetrics_UnweightedConfusionMatrix, 2},
     {"_SLmetrics_WeightedConfusionMatrix", (DL_FUNC) &_SLmetrics_WeightedConfusionMatrix, 3},
+    {"_SLmetrics_sketch_create", (DL_FUNC) &_SLmetrics_sketch_create, 5},
+    {"_SLmetrics_sketch_update", (DL_FUNC) &_SLmetrics_sketch_update, 4},
+    {"_SLmetrics_sketch_merge", (DL_FUNC) &_SLmetrics_sketch_merge, 2},
+    {"_SLmetrics_sketch_auc", (DL_FUNC) &_SLmetrics_sketch_auc, 4},
+    {"_SLmetrics_sketch_curve", (DL_FUNC) &_SLmetrics_sketch_curve, 2},
+    {"_SLmetrics_delong_auc", (DL_FUNC) &_SLmetrics_delong_auc, 4},
+    {"_SLmetrics_delong_test", (DL_FUNC) &_SLmetrics_delong_test, 4},
     {"_SLmetrics_DiagnosticOddsRatio", (DL_FUNC) &_SLmetrics_DiagnosticOddsRatio, 2},
     {"_SLmetrics_weighted_DiagnosticOddsRatio", (DL_FUNC) &_SLmetrics_weighted_DiagnosticOddsRatio, 3},
     {"_SLmetrics_cmatrix_DiagnosticOddsRatio", (DL_FUNC) &_SLmetrics_cmatrix_DiagnosticOddsRatio, 1},
@@ -1837,6 +2753,8 @@ static const R_CallMethodDef CallEntries[] = {
     {"_SLmetrics_cmatrix_Fallout", (DL_FUNC) &_SLmetrics_cmatrix_Fallout, 3},
     {"_SLmetrics_FowlkesMallowsIndex", (DL_FUNC) &_SLmetrics_FowlkesMallowsIndex, 2},
     {"_SLmetrics_cmatrix_FowlkesMallowsIndexClass", (DL_FUNC) &_SLmetrics_cmatrix_FowlkesMallowsIndexClass, 1},
+    {"_SLmetrics_roc_mauc", (DL_FUNC) &_SLmetrics_roc_mauc, 3},
+    {"_SLmetrics_roc_mauc_weighted", (DL_FUNC) &_SLmetrics_roc_mauc_weighted, 4},
     {"_SLmetrics_JaccardIndex", (DL_FUNC) &_SLmetrics_JaccardIndex, 4},
     {"_SLmetrics_weighted_JaccardIndex", (DL_FUNC) &_SLmetrics_weighted_JaccardIndex, 5},
     {"_SLmetrics_cmatrix_JaccardIndex", (DL_FUNC) &_SLmetrics_cmatrix_JaccardIndex, 3},
@@ -1860,6 +2778,8 @@ static const R_CallMethodDef CallEntries[] = {
     {"_SLmetrics_NegativePredictitveValue", (DL_FUNC) &_SLmetrics_NegativePredictitveValue, 4},
     {"_SLmetrics_weighted_NegativePredictitveValue", (DL_FUNC) &_SLmetrics_weighted_NegativePredictitveValue, 5},
     {"_SLmetrics_cmatrix_NegativePredictitveValue", (DL_FUNC) &_SLmetrics_cmatrix_NegativePredictitveValue, 3},
+    {"_SLmetrics_roc_pauc", (DL_FUNC) &_SLmetrics_roc_pauc, 7},
+    {"_SLmetrics_roc_pauc_weighted", (DL_FUNC) &_SLmetrics_roc_pauc_weighted, 8},
     {"_SLmetrics_PositiveLikelihoodRatio", (DL_FUNC) &_SLmetrics_PositiveLikelihoodRatio, 2},
     {"_SLmetrics_weighted_PositiveLikelihoodRatio", (DL_FUNC) &_SLmetrics_weighted_PositiveLikelihoodRatio, 3},
     {"_SLmetrics_cmatrix_PositiveLikelihoodRatio", (DL_FUNC) &_SLmetrics_cmatrix_PositiveLikelihoodRatio, 1},
@@ -1869,10 +2789,10 @@ static const R_CallMethodDef CallEntries[] = {
     {"_SLmetrics_PositivePredictiveValue", (DL_FUNC) &_SLmetrics_PositivePredictiveValue, 4},
     {"_SLmetrics_weighted_PositivePredictiveValue", (DL_FUNC) &_SLmetrics_weighted_PositivePredictiveValue, 5},
     {"_SLmetrics_cmatrix_PositivePredictiveValue", (DL_FUNC) &_SLmetrics_cmatrix_PositivePredictiveValue, 3},
-    {"_SLmetrics_precision_recall_curve", (DL_FUNC) &_SLmetrics_precision_recall_curve, 4},
-    {"_SLmetrics_weighted_precision_recall_curve", (DL_FUNC) &_SLmetrics_weighted_precision_recall_curve, 5},
-    {"_SLmetrics_precision_recall_auc", (DL_FUNC) &_SLmetrics_precision_recall_auc, 4},
-    {"_SLmetrics_precision_recall_auc_weighted", (DL_FUNC) &_SLmetrics_precision_recall_auc_weighted, 5},
+    {"_SLmetrics_precision_recall_curve", (DL_FUNC) &_SLmetrics_precision_recall_curve, 5},
+    {"_SLmetrics_weighted_precision_recall_curve", (DL_FUNC) &_SLmetrics_weighted_precision_recall_curve, 6},
+    {"_SLmetrics_precision_recall_auc", (DL_FUNC) &_SLmetrics_precision_recall_auc, 6},
+    {"_SLmetrics_precision_recall_auc_weighted", (DL_FUNC) &_SLmetrics_precision_recall_auc_weighted, 7},
     {"_SLmetrics_Recall", (DL_FUNC) &_SLmetrics_Recall, 4},
     {"_SLmetrics_weighted_Recall", (DL_FUNC) &_SLmetrics_weighted_Recall, 5},
     {"_SLmetrics_cmatrix_Recall", (DL_FUNC) &_SLmetrics_cmatrix_Recall, 3},
@@ -1882,10 +2802,14 @@ static const R_CallMethodDef CallEntries[] = {
     {"_SLmetrics_TruePositiveRate", (DL_FUNC) &_SLmetrics_TruePositiveRate, 4},
     {"_SLmetrics_weighted_TruePositiveRate", (DL_FUNC) &_SLmetrics_weighted_TruePositiveRate, 5},
     {"_SLmetrics_cmatrix_TruePositiveRate", (DL_FUNC) &_SLmetrics_cmatrix_TruePositiveRate, 3},
-    {"_SLmetrics_roc_curve_unweighted", (DL_FUNC) &_SLmetrics_roc_curve_unweighted, 4},
-    {"_SLmetrics_roc_curve_weighted", (DL_FUNC) &_SLmetrics_roc_curve_weighted, 5},
-    {"_SLmetrics_roc_auc", (DL_FUNC) &_SLmetrics_roc_auc, 4},
-    {"_SLmetrics_roc_auc_weighted", (DL_FUNC) &_SLmetrics_roc_auc_weighted, 5},
+    {"_SLmetrics_roc_curve_unweighted", (DL_FUNC) &_SLmetrics_roc_curve_unweighted, 5},
+    {"_SLmetrics_roc_curve_weighted", (DL_FUNC) &_SLmetrics_roc_curve_weighted, 6},
+    {"_SLmetrics_gain_curve_unweighted", (DL_FUNC) &_SLmetrics_gain_curve_unweighted, 5},
+    {"_SLmetrics_gain_curve_weighted", (DL_FUNC) &_SLmetrics_gain_curve_weighted, 6},
+    {"_SLmetrics_roc_ks", (DL_FUNC) &_SLmetrics_roc_ks, 3},
+    {"_SLmetrics_roc_ks_weighted", (DL_FUNC) &_SLmetrics_roc_ks_weighted, 4},
+    {"_SLmetrics_roc_auc", (DL_FUNC) &_SLmetrics_roc_auc, 6},
+    {"_SLmetrics_roc_auc_weighted", (DL_FUNC) &_SLmetrics_roc_auc_weighted, 7},
     {"_SLmetrics_Specificity", (DL_FUNC) &_SLmetrics_Specificity, 4},
     {"_SLmetrics_weighted_Specificity", (DL_FUNC) &_SLmetrics_weighted_Specificity, 5},
     {"_SLmetrics_cmatrix_Specificity", (DL_FUNC) &_SLmetrics_cmatrix_Specificity, 3},
@@ -1900,6 +2824,10 @@ static const R_CallMethodDef CallEntries[] = {
     {"_SLmetrics_cmatrix_ZeroOneLoss", (DL_FUNC) &_SLmetrics_cmatrix_ZeroOneLoss, 1},
     {"_SLmetrics_PoissonLogLoss", (DL_FUNC) &_SLmetrics_PoissonLogLoss, 3},
     {"_SLmetrics_weighted_PoissonLogLoss", (DL_FUNC) &_SLmetrics_weighted_PoissonLogLoss, 4},
+    {"_SLmetrics_accumulator_create", (DL_FUNC) &_SLmetrics_accumulator_create, 4},
+    {"_SLmetrics_accumulator_update", (DL_FUNC) &_SLmetrics_accumulator_update, 4},
+    {"_SLmetrics_accumulator_merge", (DL_FUNC) &_SLmetrics_accumulator_merge, 2},
+    {"_SLmetrics_accumulator_value", (DL_FUNC) &_SLmetrics_accumulator_value, 4},
     {"_SLmetrics_rsq", (DL_FUNC) &_SLmetrics_rsq, 3},
     {"_SLmetrics_weighted_rsq", (DL_FUNC) &_SLmetrics_weighted_rsq, 4},
     {"_SLmetrics_ccc", (DL_FUNC) &_SLmetrics_ccc, 3},
@@ -1914,12 +2842,50 @@ static const R_CallMethodDef CallEntries[] = {
     {"_SLmetrics_weighted_mpe", (DL_FUNC) &_SLmetrics_weighted_mpe, 3},
     {"_SLmetrics_mse", (DL_FUNC) &_SLmetrics_mse, 2},
     {"_SLmetrics_weighted_mse", (DL_FUNC) &_SLmetrics_weighted_mse, 3},
+    {"_SLmetrics_metrics", (DL_FUNC) &_SLmetrics_metrics, 7},
+    {"_SLmetrics_weighted_metrics", (DL_FUNC) &_SLmetrics_weighted_metrics, 8},
+    {"_SLmetrics_mse_matrix", (DL_FUNC) &_SLmetrics_mse_matrix, 4},
+    {"_SLmetrics_weighted_mse_matrix", (DL_FUNC) &_SLmetrics_weighted_mse_matrix, 5},
+    {"_SLmetrics_rmse_matrix", (DL_FUNC) &_SLmetrics_rmse_matrix, 4},
+    {"_SLmetrics_weighted_rmse_matrix", (DL_FUNC) &_SLmetrics_weighted_rmse_matrix, 5},
+    {"_SLmetrics_mae_matrix", (DL_FUNC) &_SLmetrics_mae_matrix, 4},
+    {"_SLmetrics_weighted_mae_matrix", (DL_FUNC) &_SLmetrics_weighted_mae_matrix, 5},
+    {"_SLmetrics_mape_matrix", (DL_FUNC) &_SLmetrics_mape_matrix, 4},
+    {"_SLmetrics_weighted_mape_matrix", (DL_FUNC) &_SLmetrics_weighted_mape_matrix, 5},
+    {"_SLmetrics_smape_matrix", (DL_FUNC) &_SLmetrics_smape_matrix, 4},
+    {"_SLmetrics_weighted_smape_matrix", (DL_FUNC) &_SLmetrics_weighted_smape_matrix, 5},
+    {"_SLmetrics_mpe_matrix", (DL_FUNC) &_SLmetrics_mpe_matrix, 4},
+    {"_SLmetrics_weighted_mpe_matrix", (DL_FUNC) &_SLmetrics_weighted_mpe_matrix, 5},
+    {"_SLmetrics_rmsle_matrix", (DL_FUNC) &_SLmetrics_rmsle_matrix, 4},
+    {"_SLmetrics_weighted_rmsle_matrix", (DL_FUNC) &_SLmetrics_weighted_rmsle_matrix, 5},
+    {"_SLmetrics_rsq_matrix", (DL_FUNC) &_SLmetrics_rsq_matrix, 5},
+    {"_SLmetrics_weighted_rsq_matrix", (DL_FUNC) &_SLmetrics_weighted_rsq_matrix, 6},
+    {"_SLmetrics_rae_matrix", (DL_FUNC) &_SLmetrics_rae_matrix, 4},
+    {"_SLmetrics_weighted_rae_matrix", (DL_FUNC) &_SLmetrics_weighted_rae_matrix, 5},
+    {"_SLmetrics_rrse_matrix", (DL_FUNC) &_SLmetrics_rrse_matrix, 4},
+    {"_SLmetrics_weighted_rrse_matrix", (DL_FUNC) &_SLmetrics_weighted_rrse_matrix, 5},
+    {"_SLmetrics_huberloss_matrix", (DL_FUNC) &_SLmetrics_huberloss_matrix, 5},
+    {"_SLmetrics_weighted_huberloss_matrix", (DL_FUNC) &_SLmetrics_weighted_huberloss_matrix, 6},
+    {"_SLmetrics_ccc_matrix", (DL_FUNC) &_SLmetrics_ccc_matrix, 5},
+    {"_SLmetrics_weighted_ccc_matrix", (DL_FUNC) &_SLmetrics_weighted_ccc_matrix, 6},
     {"_SLmetrics_pinball", (DL_FUNC) &_SLmetrics_pinball, 4},
     {"_SLmetrics_weighted_pinball", (DL_FUNC) &_SLmetrics_weighted_pinball, 5},
+    {"_SLmetrics_interval_score", (DL_FUNC) &_SLmetrics_interval_score, 3},
+    {"_SLmetrics_weighted_interval_score", (DL_FUNC) &_SLmetrics_weighted_interval_score, 4},
     {"_SLmetrics_rae", (DL_FUNC) &_SLmetrics_rae, 2},
     {"_SLmetrics_weighted_rae", (DL_FUNC) &_SLmetrics_weighted_rae, 3},
     {"_SLmetrics_RelativeRootMeanSquaredError", (DL_FUNC) &_SLmetrics_RelativeRootMeanSquaredError, 3},
     {"_SLmetrics_weighted_RelativeRootMeanSquaredError", (DL_FUNC) &_SLmetrics_weighted_RelativeRootMeanSquaredError, 4},
+    {"_SLmetrics_medae", (DL_FUNC) &_SLmetrics_medae, 2},
+    {"_SLmetrics_weighted_medae", (DL_FUNC) &_SLmetrics_weighted_medae, 3},
+    {"_SLmetrics_mdape", (DL_FUNC) &_SLmetrics_mdape, 2},
+    {"_SLmetrics_weighted_mdape", (DL_FUNC) &_SLmetrics_weighted_mdape, 3},
+    {"_SLmetrics_ae_quantile", (DL_FUNC) &_SLmetrics_ae_quantile, 3},
+    {"_SLmetrics_weighted_ae_quantile", (DL_FUNC) &_SLmetrics_weighted_ae_quantile, 4},
+    {"_SLmetrics_ae_cvar", (DL_FUNC) &_SLmetrics_ae_cvar, 3},
+    {"_SLmetrics_weighted_ae_cvar", (DL_FUNC) &_SLmetrics_weighted_ae_cvar, 4},
+    {"_SLmetrics_rolling", (DL_FUNC) &_SLmetrics_rolling, 9},
+    {"_SLmetrics_weighted_rolling", (DL_FUNC) &_SLmetrics_weighted_rolling, 10},
     {"_SLmetrics_rmse", (DL_FUNC) &_SLmetrics_rmse, 2},
     {"_SLmetrics_weighted_rmse", (DL_FUNC) &_SLmetrics_weighted_rmse, 3},
     {"_SLmetrics_rmsle", (DL_FUNC) &_SLmetrics_rmsle, 2},
@@ -1936,8 +2902,11 @@ static const R_CallMethodDef CallEntries[] = {
     {"_SLmetrics_disable_openmp", (DL_FUNC) &_SLmetrics_disable_openmp, 0},
     {"_SLmetrics_available_threads", (DL_FUNC) &_SLmetrics_available_threads, 0},
     {"_SLmetrics_use_threads", (DL_FUNC) &_SLmetrics_use_threads, 1},
-    {"_SLmetrics_sort_matrix", (DL_FUNC) &_SLmetrics_sort_matrix, 2},
-    {"_SLmetrics_order_matrix", (DL_FUNC) &_SLmetrics_order_matrix, 2},
+    {"_SLmetrics_sort_matrix", (DL_FUNC) &_SLmetrics_sort_matrix, 3},
+    {"_SLmetrics_order_matrix", (DL_FUNC) &_SLmetrics_order_matrix, 3},
+    {"_SLmetrics_ranking_matrix", (DL_FUNC) &_SLmetrics_ranking_matrix, 3},
+    {"_SLmetrics_simd_isa", (DL_FUNC) &_SLmetrics_simd_isa, 0},
+    {"_SLmetrics_use_simd", (DL_FUNC) &_SLmetrics_use_simd, 1},
     {NULL, NULL, 0}
 };
 
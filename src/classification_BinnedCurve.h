@@ -0,0 +1,369 @@
+#ifndef CLASSIFICATION_BINNEDCURVE_H
+#define CLASSIFICATION_BINNEDCURVE_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <algorithm>
+#include <limits>
+#include <cmath>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "utilities_Package.h"
+
+/**
+ * @class BinnedCurve
+ * @brief Approximate areas under the ROC and precision-recall curves from score histograms.
+ *
+ * The scores of each class are counted into B equal-width bins, so nothing is
+ * sorted and the memory is O(B * k) (per thread). The histograms are filled in
+ * one parallel pass over the rows.
+ *
+ * Within a bin the order of the positives and negatives is unknown, but the
+ * exact area is bounded by the two extreme orderings. The estimate is the
+ * midpoint of these bounds, and the returned error is half their distance:
+ *
+ *   ROC: sum_b 0.5 * P_b * N_b / (P * N)
+ *   PR:  sum_b 0.5 * (P_b / P) * (U_b - L_b)
+ *
+ * where U_b and L_b are the highest and lowest precision any positive in bin b
+ * can have. The bound holds for the trapezoidal, step and midrank integration
+ * of the exact curve.
+ */
+class BinnedCurve {
+    public:
+        // the curves
+        enum curve_type { RECEIVER_OPERATOR = 0, PRECISION_RECALL };
+
+        // integration method
+        enum integration_method { TRAPEZOIDAL = 0, STEP };
+
+        /**
+        * Compute the class-wise approximate area (one-vs-all).
+        *
+        * @param actual   Integer vector of true class labels.
+        * @param response Numeric matrix of predicted scores.
+        * @param curve    The curve; 0 for ROC and 1 for precision-recall.
+        * @param bins     The number of bins.
+        * @param method   Integration method of the exact curve the bound applies to.
+        * @param weights  Optional vector of observation weights.
+        * @return         A numeric vector of areas with the error bounds in the `error` attribute.
+        */
+        static Rcpp::NumericVector class_wise(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            int curve,
+            int bins,
+            int method = TRAPEZOIDAL,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const std::size_t n_classes { static_cast<std::size_t>(response.ncol()) };
+            const std::size_t n_bins { check_bins(bins) };
+
+            // 1) histogram each column
+            // on its own range
+            std::vector<double> positives, negatives;
+            histogram(actual, response, weights, n_bins, false, positives, negatives);
+
+            // 2) integrate each class
+            Rcpp::NumericVector output(n_classes), error(n_classes);
+            for (std::size_t c = 0; c < n_classes; c++) {
+                output[c] = area(positives.data() + c * n_bins, negatives.data() + c * n_bins, n_bins, curve, method, error[c]);
+            }
+
+            output.attr("names") = levels;
+            error.attr("names") = levels;
+            output.attr("error") = error;
+
+            return output;
+        }
+
+        /**
+        * Compute the macro-average approximate area; the error
+        * is the average of the class-wise errors.
+        */
+        static Rcpp::NumericVector macro_average(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            int curve,
+            int bins,
+            int method = TRAPEZOIDAL,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            Rcpp::NumericVector classwise { class_wise(actual, response, curve, bins, method, weights) };
+            Rcpp::NumericVector classwise_error = classwise.attr("error");
+
+            double sum { 0.0 };
+            double sum_error { 0.0 };
+            std::size_t count { 0 };
+
+            for (R_xlen_t c = 0; c < classwise.size(); c++) {
+                if (!Rcpp::NumericVector::is_na(classwise[c])) {
+                    sum += classwise[c];
+                    sum_error += classwise_error[c];
+                    count++;
+                }
+            }
+
+            Rcpp::NumericVector output = Rcpp::NumericVector::create((count > 0) ? sum / count : NA_REAL);
+            output.attr("error") = (count > 0) ? sum_error / count : NA_REAL;
+
+            return output;
+        }
+
+        /**
+        * Compute the micro-average approximate area by pooling
+        * all classes into one histogram on the range of all scores.
+        */
+        static Rcpp::NumericVector micro_average(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            int curve,
+            int bins,
+            int method = TRAPEZOIDAL,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            const std::size_t n_bins { check_bins(bins) };
+
+            std::vector<double> positives, negatives;
+            histogram(actual, response, weights, n_bins, true, positives, negatives);
+
+            double error { 0.0 };
+            Rcpp::NumericVector output = Rcpp::NumericVector::create(
+                area(positives.data(), negatives.data(), n_bins, curve, method, error)
+            );
+            output.attr("error") = error;
+
+            return output;
+        }
+
+        /**
+        * Dispatch on `micro` as the exact areas do; NULL is class-wise,
+        * TRUE is the micro average and FALSE is the macro average.
+        */
+        static Rcpp::NumericVector area_under_curve(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Rcpp::Nullable<bool>& micro,
+            int curve,
+            int bins,
+            int method = TRAPEZOIDAL,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            if (micro.isNull()) {
+                return class_wise(actual, response, curve, bins, method, weights);
+            }
+
+            if (Rcpp::as<bool>(micro)) {
+                return micro_average(actual, response, curve, bins, method, weights);
+            }
+
+            return macro_average(actual, response, curve, bins, method, weights);
+        }
+
+        /**
+        * @brief Integrate the binned curve from the highest bin down.
+        *
+        * @param positives The positive weight of each bin.
+        * @param negatives The negative weight of each bin.
+        * @param n_bins    The number of bins.
+        * @param curve     The curve; 0 for ROC and 1 for precision-recall.
+        * @param method    Integration method of the exact curve the bound applies to.
+        * @param error     Output; the bound on the absolute error.
+        * @return          The estimated area; NA if the class has no positives (or negatives for ROC).
+        */
+        static double area(
+            const double* positives,
+            const double* negatives,
+            std::size_t n_bins,
+            int curve,
+            int method,
+            double& error)
+        {
+            // 0) totals
+            double total_positives { 0.0 };
+            double total_negatives { 0.0 };
+            for (std::size_t b = 0; b < n_bins; b++) {
+                total_positives += positives[b];
+                total_negatives += negatives[b];
+            }
+
+            if (total_positives == 0.0 || (curve == RECEIVER_OPERATOR && total_negatives == 0.0)) {
+                error = NA_REAL;
+                return NA_REAL;
+            }
+
+            double output { 0.0 };
+            double true_positive { 0.0 };
+            double false_positive { 0.0 };
+            error = 0.0;
+
+            // 1) from the highest
+            // scores down
+            for (std::size_t b = n_bins; b-- > 0; ) {
+                const double p { positives[b] };
+                const double q { negatives[b] };
+
+                if (curve == RECEIVER_OPERATOR) {
+                    // 1.1) the negatives in the bin are
+                    // ranked above between none and all
+                    // of the positives in the bin
+                    output += q * (true_positive + 0.5 * p);
+                    error  += 0.5 * p * q;
+                } else if (p > 0.0) {
+                    // 1.2) the precision of any positive in
+                    // the bin is between the precision with all
+                    // negatives of the bin ranked above it, and
+                    // with all positives of the bin ranked above it
+                    const double seen { true_positive + false_positive + q };
+                    double lowest { (seen > 0.0) ? true_positive / seen : 0.0 };
+                    if (method == STEP && seen == 0.0) lowest = 1.0;
+
+                    const double highest { (true_positive + p) / (true_positive + p + false_positive) };
+
+                    output += 0.5 * p * (lowest + highest);
+                    error  += 0.5 * p * (highest - lowest);
+                }
+
+                true_positive  += p;
+                false_positive += q;
+            }
+
+            // 2) normalize
+            const double normalizer { (curve == RECEIVER_OPERATOR) ? total_positives * total_negatives : total_positives };
+            error /= normalizer;
+
+            return output / normalizer;
+        }
+
+    private:
+        static std::size_t check_bins(int bins) {
+            if (bins < 1) {
+                Rcpp::stop("`bins` must be a positive integer.");
+            }
+            return static_cast<std::size_t>(bins);
+        }
+
+        /**
+        * @brief Count the (weighted) positives and negatives of each class into bins.
+        *
+        * The bins are equal-width over the range of each column, or over the
+        * range of the whole matrix if pooled. Each thread fills its own histogram,
+        * and the histograms are summed at the end.
+        *
+        * @param actual    Integer vector of true class labels.
+        * @param response  Numeric matrix of predicted scores.
+        * @param weights   Optional vector of observation weights.
+        * @param n_bins    The number of bins.
+        * @param pooled    If true all classes share one histogram.
+        * @param positives Output; the positive weight of bin b (of class c) at [c * n_bins + b].
+        * @param negatives Output; the negative weight of bin b (of class c) at [c * n_bins + b].
+        */
+        static void histogram(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Rcpp::NumericVector* weights,
+            std::size_t n_bins,
+            bool pooled,
+            std::vector<double>& positives,
+            std::vector<double>& negatives)
+        {
+            // 0) variable declarations
+            const std::size_t n { static_cast<std::size_t>(response.nrow()) };
+            const std::size_t n_classes { static_cast<std::size_t>(response.ncol()) };
+            const std::size_t size { (pooled ? 1 : n_classes) * n_bins };
+
+            const int* ptr_actual { actual.begin() };
+            const double* ptr_response { response.begin() };
+            const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
+
+            // 1) the range of
+            // each column
+            std::vector<double> lower(n_classes, std::numeric_limits<double>::infinity());
+            std::vector<double> upper(n_classes, -std::numeric_limits<double>::infinity());
+
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < n_classes; c++) {
+                const double* col_ptr { ptr_response + c * n };
+                for (std::size_t i = 0; i < n; i++) {
+                    if (col_ptr[i] < lower[c]) lower[c] = col_ptr[i];
+                    if (col_ptr[i] > upper[c]) upper[c] = col_ptr[i];
+                }
+            }
+
+            // 1.1) pooled histograms
+            // share the range
+            if (pooled) {
+                const double pooled_lower { *std::min_element(lower.begin(), lower.end()) };
+                const double pooled_upper { *std::max_element(upper.begin(), upper.end()) };
+                std::fill(lower.begin(), lower.end(), pooled_lower);
+                std::fill(upper.begin(), upper.end(), pooled_upper);
+            }
+
+            // 1.2) the scale maps scores
+            // to bins; constant columns
+            // are one bin
+            std::vector<double> scale(n_classes, 0.0);
+            for (std::size_t c = 0; c < n_classes; c++) {
+                if (upper[c] > lower[c]) scale[c] = n_bins / (upper[c] - lower[c]);
+            }
+
+            positives.assign(size, 0.0);
+            negatives.assign(size, 0.0);
+
+            // 2) fill the histograms
+            #ifdef _OPENMP
+                #pragma omp parallel if(getUseOpenMP())
+            #endif
+            {
+                std::vector<double> local_positives(size, 0.0);
+                std::vector<double> local_negatives(size, 0.0);
+
+                #ifdef _OPENMP
+                    #pragma omp for
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    const double w { (ptr_weights != nullptr) ? ptr_weights[i] : 1.0 };
+
+                    for (std::size_t c = 0; c < n_classes; c++) {
+                        const std::size_t offset { pooled ? 0 : c * n_bins };
+                        const double x { (ptr_response[c * n + i] - lower[c]) * scale[c] };
+
+                        // NOTE: NaN scores are
+                        // counted in the lowest bin
+                        std::size_t b { (x >= static_cast<double>(n_bins)) ? n_bins - 1 : (x > 0.0) ? static_cast<std::size_t>(x) : 0 };
+
+                        if (ptr_actual[i] == static_cast<int>(c + 1)) {
+                            local_positives[offset + b] += w;
+                        } else {
+                            local_negatives[offset + b] += w;
+                        }
+                    }
+                }
+
+                #ifdef _OPENMP
+                    #pragma omp critical
+                #endif
+                {
+                    for (std::size_t j = 0; j < size; j++) {
+                        positives[j] += local_positives[j];
+                        negatives[j] += local_negatives[j];
+                    }
+                }
+            }
+        }
+
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        BinnedCurve()  = delete;
+        ~BinnedCurve() = delete;
+};
+
+#endif
@@ -0,0 +1,62 @@
+#include "classification_Calibration.h"
+
+#include <Rcpp.h>
+#include <string>
+
+using namespace Rcpp;
+
+namespace {
+
+    // the bins are equal-mass
+    // if binning is "mass"
+    int calibration_binning(const std::string& binning) {
+        if (binning == "width") return Calibration::WIDTH;
+        if (binning == "mass") return Calibration::MASS;
+
+        Rcpp::stop("`binning` must be either \"width\" or \"mass\".");
+    }
+
+}
+
+//' @rdname calibration
+//' @method calibration factor
+//' @export
+// [[Rcpp::export(calibration.factor)]]
+Rcpp::List calibration_unweighted(
+    const Rcpp::IntegerVector& actual,
+    const Rcpp::NumericMatrix& response,
+    int bins = 10,
+    std::string binning = "width",
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const int method { calibration_binning(binning) };
+
+        if (method == Calibration::MASS && ranking.isNotNull()) {
+            const Ranking ranked { Ranking::adopt(ranking.get(), response, &actual) };
+            return Calibration::compute(actual, response, bins, method, nullptr, &ranked);
+        }
+
+        return Calibration::compute(actual, response, bins, method);
+}
+
+//' @rdname calibration
+//' @method weighted.calibration factor
+//' @export
+// [[Rcpp::export(weighted.calibration.factor)]]
+Rcpp::List calibration_weighted(
+    const Rcpp::IntegerVector& actual,
+    const Rcpp::NumericMatrix& response,
+    const Rcpp::NumericVector& w,
+    int bins = 10,
+    std::string binning = "width",
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const int method { calibration_binning(binning) };
+
+        if (method == Calibration::MASS && ranking.isNotNull()) {
+            const Ranking ranked { Ranking::adopt(ranking.get(), response, &actual, &w) };
+            return Calibration::compute(actual, response, bins, method, &w, &ranked);
+        }
+
+        return Calibration::compute(actual, response, bins, method, &w);
+}
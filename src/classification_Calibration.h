@@ -0,0 +1,359 @@
+#ifndef CLASSIFICATION_CALIBRATION_H
+#define CLASSIFICATION_CALIBRATION_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "utilities_Package.h"
+#include "utilities_Ranking.h"
+
+/**
+ * @class Calibration
+ * @brief The calibration of a n x k matrix of predicted probabilities.
+ *
+ * The multiclass Brier score, the log loss and the class-wise reliability
+ * bins are accumulated in one parallel pass over the rows; each row of the
+ * response matrix is read once, and each thread owns its own bins.
+ *
+ * The bins of class c hold the weight, the summed probability p_ic and the
+ * summed indicator y_ic of the observations in the bin, so
+ *
+ *   confidence_b = sum(w * p) / sum(w)
+ *   frequency_b  = sum(w * y) / sum(w)
+ *   ECE_c        = sum_b |sum(w * y) - sum(w * p)| / W
+ *   MCE_c        = max_b |frequency_b - confidence_b|
+ *
+ * The bins are equal-width on [0, 1], or, with equal mass, cut by the
+ * cumulative weight along the (descending) ranking of each column. The
+ * equal-mass bins therefore reuse the sort of ROC() and roc.auc().
+ */
+class Calibration {
+    public:
+        // the binning
+        enum binning_type { WIDTH = 0, MASS };
+
+        /**
+        * Compute the calibration of the response.
+        *
+        * @param actual    Integer vector of true class labels.
+        * @param response  Numeric matrix of predicted probabilities.
+        * @param bins      The number of bins per class.
+        * @param binning   0 for equal-width and 1 for equal-mass bins.
+        * @param weights   Optional vector of observation weights.
+        * @param ranking   Optional ranking of `response`; only used for equal-mass bins.
+        * @return          A <calibration>-list with the brier, logloss, ece, mce and the bins.
+        */
+        static Rcpp::List compute(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            int bins = 10,
+            int binning = WIDTH,
+            const Rcpp::NumericVector* weights = nullptr,
+            const Ranking* ranking = nullptr)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const std::size_t n { static_cast<std::size_t>(response.nrow()) };
+            const std::size_t n_classes { static_cast<std::size_t>(response.ncol()) };
+
+            if (static_cast<std::size_t>(levels.size()) != n_classes) {
+                Rcpp::stop("The number of columns in `response` must match the number of levels in `actual`.");
+            }
+
+            if (bins < 1) {
+                Rcpp::stop("`bins` must be a positive integer.");
+            }
+
+            const std::size_t n_bins { static_cast<std::size_t>(bins) };
+            const std::size_t size { n_bins * n_classes };
+
+            const int* ptr_actual { actual.begin() };
+            const double* ptr_response { response.begin() };
+            const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
+
+            // the bins of all
+            // classes; bin b of class c
+            // is at c * n_bins + b
+            std::vector<double> bin_weight(size, 0.0);
+            std::vector<double> bin_confidence(size, 0.0);
+            std::vector<double> bin_frequency(size, 0.0);
+            std::vector<double> bin_lower(size, R_PosInf);
+            std::vector<double> bin_upper(size, R_NegInf);
+
+            // 1) the row pass; the scores, the
+            // equal-width bins and the totals
+            double total_weight { 0.0 };
+            double brier { 0.0 };
+            double logloss { 0.0 };
+            const bool width { binning == WIDTH };
+
+            #ifdef _OPENMP
+                #pragma omp parallel if(getUseOpenMP())
+            #endif
+            {
+                std::vector<double> local_weight(width ? size : 0, 0.0);
+                std::vector<double> local_confidence(width ? size : 0, 0.0);
+                std::vector<double> local_frequency(width ? size : 0, 0.0);
+                double local_total { 0.0 };
+                double local_brier { 0.0 };
+                double local_logloss { 0.0 };
+
+                #ifdef _OPENMP
+                    #pragma omp for
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    // the missing (or unknown)
+                    // labels are skipped
+                    bool valid { ptr_actual[i] >= 1 && static_cast<std::size_t>(ptr_actual[i]) <= n_classes };
+                    if (!valid) continue;
+
+                    const double w { (ptr_weights != nullptr) ? ptr_weights[i] : 1.0 };
+                    const std::size_t label { static_cast<std::size_t>(ptr_actual[i] - 1) };
+
+                    double squared_error { 0.0 };
+                    for (std::size_t c = 0; c < n_classes; c++) {
+                        const double p { ptr_response[c * n + i] };
+                        const double y { (c == label) ? 1.0 : 0.0 };
+                        squared_error += (p - y) * (p - y);
+
+                        if (width) {
+                            const std::size_t b { c * n_bins + bin(p, n_bins) };
+                            local_weight[b]     += w;
+                            local_confidence[b] += w * p;
+                            local_frequency[b]  += w * y;
+                        }
+                    }
+
+                    local_total   += w;
+                    local_brier   += w * squared_error;
+                    local_logloss -= w * std::log(ptr_response[label * n + i]);
+                }
+
+                #ifdef _OPENMP
+                    #pragma omp critical
+                #endif
+                {
+                    total_weight += local_total;
+                    brier        += local_brier;
+                    logloss      += local_logloss;
+
+                    for (std::size_t j = 0; j < local_weight.size(); j++) {
+                        bin_weight[j]     += local_weight[j];
+                        bin_confidence[j] += local_confidence[j];
+                        bin_frequency[j]  += local_frequency[j];
+                    }
+                }
+            }
+
+            // 1.1) the edges of the
+            // equal-width bins
+            if (width) {
+                for (std::size_t j = 0; j < size; j++) {
+                    const std::size_t b { j % n_bins };
+                    bin_lower[j] = static_cast<double>(b) / n_bins;
+                    bin_upper[j] = static_cast<double>(b + 1) / n_bins;
+                }
+            }
+
+            // 2) the equal-mass bins; along
+            // the ranking if passed, or a new sort
+            if (!width && ranking != nullptr) {
+                mass_pass(*ranking, ptr_response, ptr_actual, ptr_weights, n, n_classes, n_bins, total_weight,
+                    bin_weight, bin_confidence, bin_frequency, bin_lower, bin_upper);
+            } else if (!width) {
+                const Ranking ranked(response);
+                mass_pass(ranked, ptr_response, ptr_actual, ptr_weights, n, n_classes, n_bins, total_weight,
+                    bin_weight, bin_confidence, bin_frequency, bin_lower, bin_upper);
+            }
+
+            // 3) the calibration errors; the
+            // empty bins do not contribute
+            Rcpp::NumericVector ece(n_classes, NA_REAL);
+            Rcpp::NumericVector mce(n_classes, NA_REAL);
+
+            for (std::size_t c = 0; c < n_classes; c++) {
+                if (!(total_weight > 0.0)) continue;
+
+                double expected { 0.0 };
+                double maximum { 0.0 };
+                for (std::size_t b = c * n_bins; b < (c + 1) * n_bins; b++) {
+                    if (!(bin_weight[b] > 0.0)) continue;
+
+                    const double gap { std::fabs(bin_frequency[b] - bin_confidence[b]) };
+                    expected += gap;
+                    maximum = std::max(maximum, gap / bin_weight[b]);
+                }
+
+                ece[c] = expected / total_weight;
+                mce[c] = maximum;
+            }
+
+            ece.attr("names") = levels;
+            mce.attr("names") = levels;
+
+            // 4) the reliability bins
+            Rcpp::IntegerVector level_vector(size);
+            Rcpp::IntegerVector label_vector(size);
+            Rcpp::IntegerVector bin_vector(size);
+            Rcpp::NumericVector lower_vector(size);
+            Rcpp::NumericVector upper_vector(size);
+            Rcpp::NumericVector weight_vector(size);
+            Rcpp::NumericVector confidence_vector(size);
+            Rcpp::NumericVector frequency_vector(size);
+
+            for (std::size_t j = 0; j < size; j++) {
+                const bool empty { !(bin_weight[j] > 0.0) };
+
+                level_vector[j]      = static_cast<int>(j / n_bins + 1);
+                label_vector[j]      = static_cast<int>(j / n_bins + 1);
+                bin_vector[j]        = static_cast<int>(j % n_bins + 1);
+                lower_vector[j]      = std::isfinite(bin_lower[j]) ? bin_lower[j] : NA_REAL;
+                upper_vector[j]      = std::isfinite(bin_upper[j]) ? bin_upper[j] : NA_REAL;
+                weight_vector[j]     = bin_weight[j];
+                confidence_vector[j] = empty ? NA_REAL : bin_confidence[j] / bin_weight[j];
+                frequency_vector[j]  = empty ? NA_REAL : bin_frequency[j] / bin_weight[j];
+            }
+
+            label_vector.attr("levels") = levels;
+            label_vector.attr("class")  = "factor";
+
+            Rcpp::DataFrame reliability = Rcpp::DataFrame::create(
+                Rcpp::Named("level")      = level_vector,
+                Rcpp::Named("label")      = label_vector,
+                Rcpp::Named("bin")        = bin_vector,
+                Rcpp::Named("lower")      = lower_vector,
+                Rcpp::Named("upper")      = upper_vector,
+                Rcpp::Named("weight")     = weight_vector,
+                Rcpp::Named("confidence") = confidence_vector,
+                Rcpp::Named("frequency")  = frequency_vector
+            );
+
+            // 5) the <calibration>-object
+            const bool defined { total_weight > 0.0 };
+            Rcpp::List output = Rcpp::List::create(
+                Rcpp::Named("brier")   = defined ? brier / total_weight : NA_REAL,
+                Rcpp::Named("logloss") = defined ? logloss / total_weight : NA_REAL,
+                Rcpp::Named("ece")     = ece,
+                Rcpp::Named("mce")     = mce,
+                Rcpp::Named("bins")    = reliability
+            );
+            output.attr("class") = "calibration";
+
+            return output;
+        }
+
+    private:
+        /**
+        * @return The equal-width bin of the probability p.
+        *
+        * NOTE: NaN and negative probabilities are counted in the
+        * lowest bin, and probabilities at or above 1 in the highest.
+        */
+        static inline std::size_t bin(double p, std::size_t n_bins) {
+            const double x { p * static_cast<double>(n_bins) };
+            return (x >= static_cast<double>(n_bins)) ? n_bins - 1 : (x > 0.0) ? static_cast<std::size_t>(x) : 0;
+        }
+
+        /**
+        * @brief Fill the equal-mass bins of all classes; one class per thread.
+        */
+        static void mass_pass(
+            const Ranking& ranking,
+            const double* ptr_response,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t n,
+            std::size_t n_classes,
+            std::size_t n_bins,
+            double total_weight,
+            std::vector<double>& bin_weight,
+            std::vector<double>& bin_confidence,
+            std::vector<double>& bin_frequency,
+            std::vector<double>& bin_lower,
+            std::vector<double>& bin_upper)
+        {
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < n_classes; c++) {
+                const std::size_t offset { c * n_bins };
+
+                if (ptr_weights != nullptr) {
+                    mass_bins<true>(ranking, ptr_response + c * n, ptr_actual, ptr_weights, c, n, n_classes, n_bins, total_weight,
+                        &bin_weight[offset], &bin_confidence[offset], &bin_frequency[offset], &bin_lower[offset], &bin_upper[offset]);
+                } else {
+                    mass_bins<false>(ranking, ptr_response + c * n, ptr_actual, ptr_weights, c, n, n_classes, n_bins, total_weight,
+                        &bin_weight[offset], &bin_confidence[offset], &bin_frequency[offset], &bin_lower[offset], &bin_upper[offset]);
+                }
+            }
+        }
+
+        /**
+        * @brief Fill the equal-mass bins of class c along the ranking.
+        *
+        * An observation belongs to the bin of the midpoint of its weight
+        * on the cumulative weight, counted from the lowest probability,
+        * so each bin holds (close to) W / B of the weight.
+        */
+        template <bool weighted>
+        static void mass_bins(
+            const Ranking& ranking,
+            const double* col_ptr,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t c,
+            std::size_t n,
+            std::size_t n_classes,
+            std::size_t n_bins,
+            double total_weight,
+            double* out_weight,
+            double* out_confidence,
+            double* out_frequency,
+            double* out_lower,
+            double* out_upper)
+        {
+            if (!(total_weight > 0.0)) return;
+
+            const int class_label { static_cast<int>(c + 1) };
+            const double scale { static_cast<double>(n_bins) / total_weight };
+            double cumulative { 0.0 };
+
+            // the ranking is descending, so the
+            // lowest probabilities are at the end
+            for (std::size_t j = n; j-- > 0;) {
+                const int label { ranking.label(ptr_actual, j, c) };
+                bool valid { label >= 1 && static_cast<std::size_t>(label) <= n_classes };
+                if (!valid) continue;
+
+                const double w { ranking.weight<weighted>(ptr_weights, j, c) };
+                const double p { col_ptr[ranking.row(j, c)] };
+                const double y { (label == class_label) ? 1.0 : 0.0 };
+
+                const double x { (cumulative + 0.5 * w) * scale };
+                const std::size_t b { (x >= static_cast<double>(n_bins)) ? n_bins - 1 : (x > 0.0) ? static_cast<std::size_t>(x) : 0 };
+
+                out_weight[b]     += w;
+                out_confidence[b] += w * p;
+                out_frequency[b]  += w * y;
+                out_lower[b]       = std::min(out_lower[b], p);
+                out_upper[b]       = std::max(out_upper[b], p);
+
+                cumulative += w;
+            }
+        }
+
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        Calibration()  = delete;
+        ~Calibration() = delete;
+};
+
+#endif
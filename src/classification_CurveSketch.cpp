@@ -0,0 +1,79 @@
+#include "classification_CurveSketch.h"
+
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+//' @rdname sketch
+//' @method sketch factor
+//' @export
+// [[Rcpp::export(sketch.factor)]]
+Rcpp::List sketch_create(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    Rcpp::Nullable<Rcpp::NumericVector> w = R_NilValue,
+    int bins = 1000,
+    Rcpp::Nullable<Rcpp::NumericVector> breaks = R_NilValue) {
+
+        // 1) the edges; a uniform
+        // grid on [0, 1] by default
+        Rcpp::NumericVector edges;
+        if (breaks.isNotNull()) {
+            edges = Rcpp::as<Rcpp::NumericVector>(breaks);
+        } else {
+            if (bins < 1) {
+                Rcpp::stop("`bins` must be a positive integer.");
+            }
+
+            edges = Rcpp::NumericVector(bins + 1);
+            for (int b = 0; b <= bins; b++) {
+                edges[b] = static_cast<double>(b) / bins;
+            }
+        }
+
+        // 2) the sketch
+        if (w.isNotNull()) {
+            const Rcpp::NumericVector weights(w);
+            return CurveSketch::create(actual, response, edges, &weights);
+        }
+
+        return CurveSketch::create(actual, response, edges);
+}
+
+// [[Rcpp::export(.sketch_update)]]
+Rcpp::List sketch_update(
+    const Rcpp::List sketch,
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    Rcpp::Nullable<Rcpp::NumericVector> w = R_NilValue) {
+
+        if (w.isNotNull()) {
+            const Rcpp::NumericVector weights(w);
+            return CurveSketch::update(sketch, actual, response, &weights);
+        }
+
+        return CurveSketch::update(sketch, actual, response);
+}
+
+// [[Rcpp::export(.sketch_merge)]]
+Rcpp::List sketch_merge(
+    const Rcpp::List x,
+    const Rcpp::List y) {
+        return CurveSketch::merge(x, y);
+}
+
+// [[Rcpp::export(.sketch_auc)]]
+Rcpp::NumericVector sketch_auc(
+    const Rcpp::List sketch,
+    Rcpp::Nullable<bool> micro = R_NilValue,
+    int curve = 0,
+    int method = 0) {
+        return CurveSketch::area_under_curve(sketch, micro, curve, method);
+}
+
+// [[Rcpp::export(.sketch_curve)]]
+Rcpp::DataFrame sketch_curve(
+    const Rcpp::List sketch,
+    int curve = 0) {
+        return CurveSketch::curve(sketch, curve);
+}
@@ -0,0 +1,413 @@
+#ifndef CLASSIFICATION_CURVESKETCH_H
+#define CLASSIFICATION_CURVESKETCH_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "utilities_Package.h"
+#include "classification_BinnedCurve.h"
+
+/**
+ * @class CurveSketch
+ * @brief A mergeable sketch of the ROC and precision-recall curves.
+ *
+ * The sketch is the per-class positive and negative score histograms on
+ * fixed bin edges (breaks). Because the edges are fixed, two sketches of the
+ * same breaks and levels are merged by adding the histograms, and the order
+ * in which batches arrive does not matter. The memory is O(B * k) regardless
+ * of the number of observations, and an update is O(batch * log B).
+ *
+ * The sketch is a list of class <sketch> with the elements:
+ *   - levels:    the levels of the actual classes.
+ *   - breaks:    the B + 1 increasing bin edges.
+ *   - positives: B x k numeric matrix of the positive weight of each bin and class.
+ *   - negatives: B x k numeric matrix of the negative weight of each bin and class.
+ *
+ * The areas (and their error bounds) and the curves are computed from
+ * the histograms as in BinnedCurve.
+ */
+class CurveSketch {
+    public:
+        /**
+        * Create a sketch from a batch.
+        *
+        * @param actual   Integer vector of true class labels.
+        * @param response Numeric matrix of predicted scores.
+        * @param breaks   The increasing bin edges.
+        * @param weights  Optional vector of observation weights.
+        */
+        static Rcpp::List create(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Rcpp::NumericVector& breaks,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            // 0) validate the breaks
+            const R_xlen_t n_edges { breaks.size() };
+            if (n_edges < 2) {
+                Rcpp::stop("`breaks` must have at least two values.");
+            }
+            for (R_xlen_t b = 1; b < n_edges; b++) {
+                if (!(breaks[b] > breaks[b - 1])) {
+                    Rcpp::stop("`breaks` must be strictly increasing.");
+                }
+            }
+
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const R_xlen_t n_bins { n_edges - 1 };
+
+            // 1) the empty sketch
+            Rcpp::List output = Rcpp::List::create(
+                Rcpp::Named("levels")    = levels,
+                Rcpp::Named("breaks")    = Rcpp::clone(breaks),
+                Rcpp::Named("positives") = Rcpp::NumericMatrix(n_bins, levels.size()),
+                Rcpp::Named("negatives") = Rcpp::NumericMatrix(n_bins, levels.size())
+            );
+            output.attr("class") = "sketch";
+
+            // 2) add the batch
+            return update(output, actual, response, weights);
+        }
+
+        /**
+        * Add a batch to a copy of the sketch.
+        *
+        * @param sketch   A <sketch>-object.
+        * @param actual   Integer vector of true class labels.
+        * @param response Numeric matrix of predicted scores.
+        * @param weights  Optional vector of observation weights.
+        */
+        static Rcpp::List update(
+            const Rcpp::List& sketch,
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = sketch["levels"];
+            Rcpp::NumericVector breaks = sketch["breaks"];
+            Rcpp::NumericMatrix positives = Rcpp::clone(Rcpp::as<Rcpp::NumericMatrix>(sketch["positives"]));
+            Rcpp::NumericMatrix negatives = Rcpp::clone(Rcpp::as<Rcpp::NumericMatrix>(sketch["negatives"]));
+
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+            const std::size_t n_classes { static_cast<std::size_t>(levels.size()) };
+            const std::size_t n_bins { static_cast<std::size_t>(breaks.size() - 1) };
+
+            if (static_cast<std::size_t>(response.ncol()) != n_classes || static_cast<std::size_t>(response.nrow()) != n) {
+                Rcpp::stop("The dimensions of `response` must be %d x %d.", static_cast<int>(n), static_cast<int>(n_classes));
+            }
+
+            Rcpp::CharacterVector actual_levels = actual.attr("levels");
+            if (!same_levels(levels, actual_levels)) {
+                Rcpp::stop("The levels of `actual` does not match the levels of the sketch.");
+            }
+
+            const int* ptr_actual { actual.begin() };
+            const double* ptr_response { response.begin() };
+            const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
+            const double* ptr_breaks { breaks.begin() };
+            double* ptr_positives { positives.begin() };
+            double* ptr_negatives { negatives.begin() };
+
+            // 1) fill the histograms; one
+            // per thread, summed at the end
+            const std::size_t size { n_bins * n_classes };
+
+            #ifdef _OPENMP
+                #pragma omp parallel if(getUseOpenMP())
+            #endif
+            {
+                std::vector<double> local_positives(size, 0.0);
+                std::vector<double> local_negatives(size, 0.0);
+
+                #ifdef _OPENMP
+                    #pragma omp for
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    const double w { (ptr_weights != nullptr) ? ptr_weights[i] : 1.0 };
+
+                    for (std::size_t c = 0; c < n_classes; c++) {
+                        const std::size_t b { bin(ptr_breaks, n_bins, ptr_response[c * n + i]) };
+
+                        if (ptr_actual[i] == static_cast<int>(c + 1)) {
+                            local_positives[c * n_bins + b] += w;
+                        } else {
+                            local_negatives[c * n_bins + b] += w;
+                        }
+                    }
+                }
+
+                #ifdef _OPENMP
+                    #pragma omp critical
+                #endif
+                {
+                    for (std::size_t j = 0; j < size; j++) {
+                        ptr_positives[j] += local_positives[j];
+                        ptr_negatives[j] += local_negatives[j];
+                    }
+                }
+            }
+
+            return rebuild(sketch, positives, negatives);
+        }
+
+        /**
+        * Merge two sketches of the same levels and breaks.
+        */
+        static Rcpp::List merge(
+            const Rcpp::List& x,
+            const Rcpp::List& y)
+        {
+            // 0) the sketches must be
+            // on the same bins
+            Rcpp::CharacterVector x_levels = x["levels"], y_levels = y["levels"];
+            Rcpp::NumericVector x_breaks = x["breaks"], y_breaks = y["breaks"];
+
+            if (!same_levels(x_levels, y_levels)) {
+                Rcpp::stop("The sketches must have the same levels.");
+            }
+            if (x_breaks.size() != y_breaks.size() || !std::equal(x_breaks.begin(), x_breaks.end(), y_breaks.begin())) {
+                Rcpp::stop("The sketches must have the same breaks.");
+            }
+
+            // 1) add the histograms
+            Rcpp::NumericMatrix positives = Rcpp::clone(Rcpp::as<Rcpp::NumericMatrix>(x["positives"]));
+            Rcpp::NumericMatrix negatives = Rcpp::clone(Rcpp::as<Rcpp::NumericMatrix>(x["negatives"]));
+            Rcpp::NumericMatrix y_positives = y["positives"];
+            Rcpp::NumericMatrix y_negatives = y["negatives"];
+
+            for (R_xlen_t j = 0; j < positives.size(); j++) {
+                positives[j] += y_positives[j];
+                negatives[j] += y_negatives[j];
+            }
+
+            return rebuild(x, positives, negatives);
+        }
+
+        /**
+        * The area under the ROC or precision-recall curve of the sketch.
+        *
+        * @param sketch A <sketch>-object.
+        * @param micro  NULL for class-wise, TRUE for the micro average and FALSE for the macro average.
+        * @param curve  The curve; 0 for ROC and 1 for precision-recall.
+        * @param method Integration method of the exact curve the bound applies to.
+        * @return       The areas with the error bounds in the `error` attribute.
+        */
+        static Rcpp::NumericVector area_under_curve(
+            const Rcpp::List& sketch,
+            const Rcpp::Nullable<bool>& micro,
+            int curve,
+            int method)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = sketch["levels"];
+            Rcpp::NumericMatrix positives = sketch["positives"];
+            Rcpp::NumericMatrix negatives = sketch["negatives"];
+
+            const std::size_t n_bins { static_cast<std::size_t>(positives.nrow()) };
+            const std::size_t n_classes { static_cast<std::size_t>(positives.ncol()) };
+
+            // 1) micro average; all
+            // classes share the bins
+            if (micro.isNotNull() && Rcpp::as<bool>(micro)) {
+                std::vector<double> pooled_positives(n_bins, 0.0), pooled_negatives(n_bins, 0.0);
+                for (std::size_t c = 0; c < n_classes; c++) {
+                    for (std::size_t b = 0; b < n_bins; b++) {
+                        pooled_positives[b] += positives(b, c);
+                        pooled_negatives[b] += negatives(b, c);
+                    }
+                }
+
+                double error { 0.0 };
+                Rcpp::NumericVector output = Rcpp::NumericVector::create(
+                    BinnedCurve::area(pooled_positives.data(), pooled_negatives.data(), n_bins, curve, method, error)
+                );
+                output.attr("error") = error;
+
+                return output;
+            }
+
+            // 2) class-wise
+            Rcpp::NumericVector output(n_classes), error(n_classes);
+            for (std::size_t c = 0; c < n_classes; c++) {
+                output[c] = BinnedCurve::area(&positives(0, c), &negatives(0, c), n_bins, curve, method, error[c]);
+            }
+
+            if (micro.isNull()) {
+                output.attr("names") = levels;
+                error.attr("names") = levels;
+                output.attr("error") = error;
+
+                return output;
+            }
+
+            // 3) macro average
+            double sum { 0.0 }, sum_error { 0.0 };
+            std::size_t count { 0 };
+            for (std::size_t c = 0; c < n_classes; c++) {
+                if (!std::isnan(output[c])) {
+                    sum += output[c];
+                    sum_error += error[c];
+                    count++;
+                }
+            }
+
+            Rcpp::NumericVector macro = Rcpp::NumericVector::create((count > 0) ? sum / count : NA_REAL);
+            macro.attr("error") = (count > 0) ? sum_error / count : NA_REAL;
+
+            return macro;
+        }
+
+        /**
+        * The ROC or precision-recall curve of the sketch, evaluated at
+        * the lower edge of each bin.
+        *
+        * @param sketch A <sketch>-object.
+        * @param curve  The curve; 0 for ROC and 1 for precision-recall.
+        * @return       A <ROC> or <prROC> data.frame.
+        */
+        static Rcpp::DataFrame curve(
+            const Rcpp::List& sketch,
+            int curve)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = sketch["levels"];
+            Rcpp::NumericVector breaks = sketch["breaks"];
+            Rcpp::NumericMatrix positives = sketch["positives"];
+            Rcpp::NumericMatrix negatives = sketch["negatives"];
+
+            const std::size_t n_bins { static_cast<std::size_t>(positives.nrow()) };
+            const std::size_t n_classes { static_cast<std::size_t>(positives.ncol()) };
+            const std::size_t n_points { n_bins + 1 };
+
+            Rcpp::NumericVector thresholds_vector(n_points * n_classes);
+            Rcpp::IntegerVector levels_vector(n_points * n_classes);
+            Rcpp::NumericVector x_vector(n_points * n_classes);
+            Rcpp::NumericVector y_vector(n_points * n_classes);
+
+            // 1) one point per bin, from
+            // the highest scores down
+            for (std::size_t c = 0; c < n_classes; c++) {
+                double total_positives { 0.0 }, total_negatives { 0.0 };
+                for (std::size_t b = 0; b < n_bins; b++) {
+                    total_positives += positives(b, c);
+                    total_negatives += negatives(b, c);
+                }
+
+                double true_positive { 0.0 }, false_positive { 0.0 };
+                std::size_t idx { c * n_points };
+
+                // 1.1) the starting point
+                thresholds_vector[idx] = R_PosInf;
+                levels_vector[idx] = static_cast<int>(c + 1);
+                x_vector[idx] = 0.0;
+                y_vector[idx] = (curve == BinnedCurve::RECEIVER_OPERATOR) ? 0.0 : 1.0;
+
+                for (std::size_t b = n_bins; b-- > 0; ) {
+                    true_positive  += positives(b, c);
+                    false_positive += negatives(b, c);
+                    idx++;
+
+                    thresholds_vector[idx] = breaks[b];
+                    levels_vector[idx] = static_cast<int>(c + 1);
+
+                    if (curve == BinnedCurve::RECEIVER_OPERATOR) {
+                        x_vector[idx] = (total_positives > 0.0) ? true_positive / total_positives : 0.0;
+                        y_vector[idx] = (total_negatives > 0.0) ? false_positive / total_negatives : 0.0;
+                    } else {
+                        x_vector[idx] = (total_positives > 0.0) ? true_positive / total_positives : 0.0;
+                        y_vector[idx] = (true_positive + false_positive > 0.0) ? true_positive / (true_positive + false_positive) : 1.0;
+                    }
+                }
+            }
+
+            // 2) the label column is the
+            // level column with the levels attached, ie. a factor
+            Rcpp::IntegerVector label_vector = Rcpp::clone(levels_vector);
+            label_vector.attr("levels") = levels;
+            label_vector.attr("class")  = "factor";
+
+            if (curve == BinnedCurve::RECEIVER_OPERATOR) {
+                Rcpp::DataFrame output = Rcpp::DataFrame::create(
+                    Rcpp::Named("threshold") = thresholds_vector,
+                    Rcpp::Named("level")     = levels_vector,
+                    Rcpp::Named("label")     = label_vector,
+                    Rcpp::Named("tpr")       = x_vector,
+                    Rcpp::Named("fpr")       = y_vector
+                );
+                output.attr("class") = Rcpp::CharacterVector::create("ROC", "data.frame");
+                return output;
+            }
+
+            Rcpp::DataFrame output = Rcpp::DataFrame::create(
+                Rcpp::Named("threshold") = thresholds_vector,
+                Rcpp::Named("level")     = levels_vector,
+                Rcpp::Named("label")     = label_vector,
+                Rcpp::Named("recall")    = x_vector,
+                Rcpp::Named("precision") = y_vector
+            );
+            output.attr("class") = Rcpp::CharacterVector::create("prROC", "data.frame");
+            return output;
+        }
+
+    private:
+        /**
+        * @return The bin of the score; scores outside the
+        *         breaks are counted in the first or last bin, and
+        *         NaN in the first.
+        */
+        static inline std::size_t bin(
+            const double* breaks,
+            std::size_t n_bins,
+            double score)
+        {
+            if (!(score > breaks[0])) return 0;
+            if (score >= breaks[n_bins]) return n_bins - 1;
+
+            return static_cast<std::size_t>(std::upper_bound(breaks, breaks + n_bins + 1, score) - breaks) - 1;
+        }
+
+        static bool same_levels(
+            const Rcpp::CharacterVector& x,
+            const Rcpp::CharacterVector& y)
+        {
+            if (x.size() != y.size()) return false;
+            for (R_xlen_t i = 0; i < x.size(); i++) {
+                if (x[i] != y[i]) return false;
+            }
+            return true;
+        }
+
+        static Rcpp::List rebuild(
+            const Rcpp::List& sketch,
+            const Rcpp::NumericMatrix& positives,
+            const Rcpp::NumericMatrix& negatives)
+        {
+            Rcpp::CharacterVector levels = sketch["levels"];
+            Rcpp::NumericVector breaks = sketch["breaks"];
+
+            Rcpp::List output = Rcpp::List::create(
+                Rcpp::Named("levels")    = levels,
+                Rcpp::Named("breaks")    = breaks,
+                Rcpp::Named("positives") = positives,
+                Rcpp::Named("negatives") = negatives
+            );
+            output.attr("class") = "sketch";
+
+            return output;
+        }
+
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        CurveSketch()  = delete;
+        ~CurveSketch() = delete;
+};
+
+#endif
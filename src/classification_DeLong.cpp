@@ -0,0 +1,35 @@
+#include "classification_DeLong.h"
+
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+//' @rdname delong
+//' @method delong factor
+//' @export
+// [[Rcpp::export(delong.factor)]]
+Rcpp::DataFrame delong_auc(
+    const Rcpp::IntegerVector& actual,
+    const Rcpp::NumericMatrix& response,
+    double level = 0.95,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response) };
+
+        return DeLong::class_wise(actual, response, ranked, level);
+}
+
+//' @rdname roc.test
+//' @method roc.test factor
+//' @export
+// [[Rcpp::export(roc.test.factor)]]
+Rcpp::List delong_test(
+    const Rcpp::IntegerVector& actual,
+    const Rcpp::NumericMatrix& response,
+    int positive = 1,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response) };
+
+        return DeLong::paired(actual, response, ranked, positive);
+}
@@ -0,0 +1,409 @@
+#ifndef CLASSIFICATION_DELONG_H
+#define CLASSIFICATION_DELONG_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <algorithm>
+#include <cmath>
+#include <string>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "utilities_Package.h"
+#include "utilities_Ranking.h"
+
+/**
+ * @class DeLong
+ * @brief The AUC and its DeLong variance for each class (one-vs-all).
+ *
+ * The variance follows the fast algorithm of Sun and Xu (2014): the
+ * structural components (placements) of each observation are the midranks
+ * of the observation in the pooled sample minus its midrank among its own
+ * class. Both come out of a single descending scan of the ranking, where
+ * the tied scores form groups:
+ *
+ *   V10 (positives) = (N_below + 0.5 * N_tied) / N
+ *   V01 (negatives) = (P_above + 0.5 * P_tied) / P
+ *
+ * The AUC is the mean of V10 over the positives, and the variance is
+ *
+ *   Var(AUC) = S10 / P + S01 / N
+ *
+ * where S10 and S01 are the sample variances of V10 and V01. So apart from
+ * the ranking, which can be shared with the other ROC-functions, it is O(n).
+ *
+ * For m models scored on the same observations, the covariances of the
+ * AUCs are the sample covariances of their placements, which gives the
+ * paired tests of DeLong et al. (1988).
+ */
+class DeLong {
+    public:
+        /**
+        * Compute the AUC, the DeLong standard error and confidence interval for each class.
+        *
+        * @param actual   Integer vector of true class labels.
+        * @param response Numeric matrix of predicted scores.
+        * @param ranking  The column-wise descending ordering of `response`.
+        * @param level    The confidence level of the interval.
+        * @return         A DataFrame with columns: label (factor), auc, se, lower and upper.
+        */
+        static Rcpp::DataFrame class_wise(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            double level = 0.95)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+            const std::size_t n_classes { static_cast<std::size_t>(levels.size()) };
+
+            if (!(level > 0.0 && level < 1.0)) {
+                Rcpp::stop("The `level` must be between 0 and 1.");
+            }
+
+            // the quantile of the
+            // confidence interval
+            const double z { R::qnorm(0.5 + 0.5 * level, 0.0, 1.0, 1, 0) };
+
+            // output containers
+            Rcpp::IntegerVector label_vector(n_classes);
+            Rcpp::NumericVector auc_vector(n_classes);
+            Rcpp::NumericVector se_vector(n_classes);
+            Rcpp::NumericVector lower_vector(n_classes);
+            Rcpp::NumericVector upper_vector(n_classes);
+
+            int* ptr_label { label_vector.begin() };
+            double* ptr_auc { auc_vector.begin() };
+            double* ptr_se { se_vector.begin() };
+            double* ptr_lower { lower_vector.begin() };
+            double* ptr_upper { upper_vector.begin() };
+
+            const int* ptr_actual { actual.begin() };
+
+            // 1) compute the AUC and
+            // variance for each class
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < n_classes; ++c) {
+
+                // 1.1) the placements
+                // of each observation
+                int class_label { static_cast<int>(c + 1) };
+                std::vector<double> placements(n);
+                double positives { 0.0 };
+                double negatives { 0.0 };
+
+                double auc { structural_components(ranking, &response(0, c), ptr_actual, c, n, class_label, placements.data(), positives, negatives) };
+                double variance { delong_covariance(ptr_actual, class_label, n, placements.data(), auc, placements.data(), auc, positives, negatives) };
+
+                // 1.2) store the values
+                // and clamp the interval to
+                // the unit interval
+                double se { std::sqrt(variance) };
+
+                ptr_label[c] = class_label;
+                ptr_auc[c] = auc;
+                ptr_se[c] = se;
+                ptr_lower[c] = ISNAN(se) ? NA_REAL : std::max(0.0, auc - z * se);
+                ptr_upper[c] = ISNAN(se) ? NA_REAL : std::min(1.0, auc + z * se);
+            }
+
+            // 2) the label is a factor
+            label_vector.attr("levels") = levels;
+            label_vector.attr("class") = "factor";
+
+            // 3) construct the DataFrame
+            Rcpp::DataFrame output = Rcpp::DataFrame::create(
+                Rcpp::Named("label") = label_vector,
+                Rcpp::Named("auc")   = auc_vector,
+                Rcpp::Named("se")    = se_vector,
+                Rcpp::Named("lower") = lower_vector,
+                Rcpp::Named("upper") = upper_vector
+            );
+            output.attr("class") = Rcpp::CharacterVector::create("DeLong", "data.frame");
+
+            return output;
+        }
+
+        /**
+        * Compare the correlated AUCs of m models scored on the same observations.
+        *
+        * The placements of all models are computed in parallel (one model per thread), and
+        * the DeLong covariance matrix is computed from them in parallel over the pairs of models.
+        * Each pair is tested with,
+        *
+        *   z = (AUC_r - AUC_s) / sqrt(Var(AUC_r) + Var(AUC_s) - 2 Cov(AUC_r, AUC_s))
+        *
+        * @param actual   Integer vector of true class labels.
+        * @param response Numeric matrix of predicted scores; one column per model.
+        * @param ranking  The column-wise descending ordering of `response`.
+        * @param positive The positive class label (1-based).
+        * @return         A list with the AUCs, the covariance matrix and the statistics and p-values of the pairwise tests.
+        */
+        static Rcpp::List paired(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            int positive = 1)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+            const std::size_t n_models { static_cast<std::size_t>(response.ncol()) };
+
+            if (positive < 1 || positive > levels.size()) {
+                Rcpp::stop("The `positive` class must be between 1 and %d.", static_cast<int>(levels.size()));
+            }
+
+            // output containers
+            Rcpp::NumericVector auc_vector(n_models);
+            Rcpp::NumericMatrix covariance(n_models, n_models);
+            Rcpp::NumericMatrix statistic(n_models, n_models);
+            Rcpp::NumericMatrix p_value(n_models, n_models);
+
+            double* ptr_auc { auc_vector.begin() };
+            double* ptr_covariance { covariance.begin() };
+            double* ptr_statistic { statistic.begin() };
+            double* ptr_p_value { p_value.begin() };
+
+            const int* ptr_actual { actual.begin() };
+
+            // the placements of
+            // each model, by column
+            std::vector<double> placements(n * n_models);
+            double positives { 0.0 };
+            double negatives { 0.0 };
+
+            // 1) the placements and
+            // AUC of each model
+            //
+            // NOTE: the positives and negatives are
+            // the same for all models
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t m = 0; m < n_models; ++m) {
+                double model_positives { 0.0 };
+                double model_negatives { 0.0 };
+
+                ptr_auc[m] = structural_components(ranking, &response(0, m), ptr_actual, m, n, positive, placements.data() + m * n, model_positives, model_negatives);
+
+                if (m == 0) {
+                    positives = model_positives;
+                    negatives = model_negatives;
+                }
+            }
+
+            // 2) the covariance matrix
+            //
+            // NOTE: each pair (r, s) with r <= s
+            // is computed once, and mirrored
+            const std::size_t n_pairs { n_models * (n_models + 1) / 2 };
+
+            #ifdef _OPENMP
+                #pragma omp parallel for schedule(dynamic) if(getUseOpenMP())
+            #endif
+            for (std::size_t pair = 0; pair < n_pairs; ++pair) {
+
+                // 2.1) map the pair index
+                // to (r, s)
+                std::size_t r { 0 };
+                std::size_t offset { pair };
+                while (offset >= n_models - r) {
+                    offset -= n_models - r;
+                    r++;
+                }
+                const std::size_t s { r + offset };
+
+                // 2.2) the covariance
+                // of the pair
+                double cov { delong_covariance(ptr_actual, positive, n, placements.data() + r * n, ptr_auc[r], placements.data() + s * n, ptr_auc[s], positives, negatives) };
+
+                ptr_covariance[r + s * n_models] = cov;
+                ptr_covariance[s + r * n_models] = cov;
+            }
+
+            // 3) the pairwise tests
+            for (std::size_t r = 0; r < n_models; ++r) {
+                for (std::size_t s = 0; s < n_models; ++s) {
+
+                    if (r == s) {
+                        ptr_statistic[r + s * n_models] = NA_REAL;
+                        ptr_p_value[r + s * n_models] = NA_REAL;
+                        continue;
+                    }
+
+                    double variance {
+                        ptr_covariance[r + r * n_models] + ptr_covariance[s + s * n_models] - 2.0 * ptr_covariance[r + s * n_models]
+                    };
+
+                    double z { (variance > 0.0) ? (ptr_auc[r] - ptr_auc[s]) / std::sqrt(variance) : NA_REAL };
+
+                    ptr_statistic[r + s * n_models] = z;
+                    ptr_p_value[r + s * n_models] = ISNAN(z) ? NA_REAL : 2.0 * R::pnorm(-std::fabs(z), 0.0, 1.0, 1, 0);
+                }
+            }
+
+            // 4) the names of the
+            // models (if any)
+            Rcpp::CharacterVector model_names(n_models);
+            Rcpp::RObject dimnames { response.attr("dimnames") };
+            if (!Rf_isNull(dimnames) && !Rf_isNull(VECTOR_ELT(dimnames, 1))) {
+                model_names = VECTOR_ELT(dimnames, 1);
+            } else {
+                for (std::size_t m = 0; m < n_models; ++m) {
+                    model_names[m] = "model" + std::to_string(m + 1);
+                }
+            }
+
+            auc_vector.attr("names") = model_names;
+            Rcpp::List matrix_names = Rcpp::List::create(model_names, model_names);
+            covariance.attr("dimnames") = matrix_names;
+            statistic.attr("dimnames") = matrix_names;
+            p_value.attr("dimnames") = matrix_names;
+
+            // 5) construct the list
+            Rcpp::List output = Rcpp::List::create(
+                Rcpp::Named("auc")        = auc_vector,
+                Rcpp::Named("covariance") = covariance,
+                Rcpp::Named("statistic")  = statistic,
+                Rcpp::Named("p.value")    = p_value,
+                Rcpp::Named("positive")   = Rcpp::CharacterVector::create(levels[positive - 1])
+            );
+            output.attr("class") = "roc.test";
+
+            return output;
+        }
+
+        /**
+        * Compute the structural components (placements) of column c.
+        *
+        * @param ranking     The column-wise descending ordering of the response matrix.
+        * @param col_ptr     Pointer to column c of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels.
+        * @param c           The column of the ranking.
+        * @param n           The number of rows.
+        * @param class_label The positive class label.
+        * @param placements  Output of length n; V10 for the positives and V01 for the negatives, by row.
+        * @param positives   Output; the number of positives.
+        * @param negatives   Output; the number of negatives.
+        * @return            The AUC, or NA if there are no positives or negatives.
+        */
+        static double structural_components(
+            const Ranking& ranking,
+            const double* col_ptr,
+            const int* ptr_actual,
+            std::size_t c,
+            std::size_t n,
+            int class_label,
+            double* placements,
+            double& positives,
+            double& negatives)
+        {
+            // 0) count the positives
+            // and negatives
+            positives = 0.0;
+            for (std::size_t i = 0; i < n; i++) {
+                if (ranking.label(ptr_actual, i, c) == class_label) positives += 1.0;
+            }
+            negatives = static_cast<double>(n) - positives;
+
+            if (positives == 0.0 || negatives == 0.0) {
+                return NA_REAL;
+            }
+
+            // 1) scan the tied groups
+            // in descending order
+            double auc { 0.0 };
+            double positives_above { 0.0 };
+            double negatives_above { 0.0 };
+
+            for (std::size_t i = 0; i < n; ) {
+                const double score { col_ptr[ranking.row(i, c)] };
+                double group_positives { 0.0 };
+
+                // 1.1) the size of the
+                // group
+                std::size_t j = i;
+                do {
+                    if (ranking.label(ptr_actual, j, c) == class_label) group_positives += 1.0;
+                    j++;
+                } while (j < n && col_ptr[ranking.row(j, c)] == score);
+
+                const double group_negatives { static_cast<double>(j - i) - group_positives };
+
+                // 1.2) the placements are
+                // constant within the group
+                const double v10 { (negatives - negatives_above - 0.5 * group_negatives) / negatives };
+                const double v01 { (positives_above + 0.5 * group_positives) / positives };
+
+                for (std::size_t k = i; k < j; k++) {
+                    placements[ranking.row(k, c)] = (ranking.label(ptr_actual, k, c) == class_label) ? v10 : v01;
+                }
+
+                auc += group_positives * v10;
+                positives_above += group_positives;
+                negatives_above += group_negatives;
+                i = j;
+            }
+
+            return auc / positives;
+        }
+
+        /**
+        * Compute the DeLong covariance between two AUCs on the same observations.
+        *
+        * @param ptr_actual  Pointer to the actual class labels.
+        * @param class_label The positive class label.
+        * @param n           The number of rows.
+        * @param placements_r The placements of the first AUC.
+        * @param auc_r        The first AUC.
+        * @param placements_s The placements of the second AUC.
+        * @param auc_s        The second AUC.
+        * @param positives   The number of positives.
+        * @param negatives   The number of negatives.
+        * @return            The covariance (the variance if r = s), or NA if it is undefined.
+        */
+        static double delong_covariance(
+            const int* ptr_actual,
+            int class_label,
+            std::size_t n,
+            const double* placements_r,
+            double auc_r,
+            const double* placements_s,
+            double auc_s,
+            double positives,
+            double negatives)
+        {
+            if (positives < 2.0 || negatives < 2.0 || ISNAN(auc_r) || ISNAN(auc_s)) {
+                return NA_REAL;
+            }
+
+            double s10 { 0.0 };
+            double s01 { 0.0 };
+
+            for (std::size_t i = 0; i < n; i++) {
+                double cross { (placements_r[i] - auc_r) * (placements_s[i] - auc_s) };
+                if (ptr_actual[i] == class_label) {
+                    s10 += cross;
+                } else {
+                    s01 += cross;
+                }
+            }
+
+            return s10 / ((positives - 1.0) * positives) + s01 / ((negatives - 1.0) * negatives);
+        }
+
+    private:
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        DeLong()  = delete;
+        ~DeLong() = delete;
+};
+
+#endif
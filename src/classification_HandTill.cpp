@@ -0,0 +1,32 @@
+#include "classification_HandTill.h"
+
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+//' @rdname roc.mauc
+//' @method roc.mauc matrix
+//' @export
+// [[Rcpp::export(roc.mauc.matrix)]]
+double roc_mauc(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response) };
+        return HandTill::m_measure(actual, response, ranked);
+}
+
+//' @rdname roc.mauc
+//' @method weighted.roc.mauc matrix
+//' @export
+// [[Rcpp::export(weighted.roc.mauc.matrix)]]
+double roc_mauc_weighted(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    const Rcpp::NumericVector w,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual, &w) : Ranking(response) };
+        return HandTill::m_measure(actual, response, ranked, &w);
+}
@@ -0,0 +1,189 @@
+#ifndef CLASSIFICATION_HANDTILL_H
+#define CLASSIFICATION_HANDTILL_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <cmath>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "utilities_Package.h"
+#include "utilities_Ranking.h"
+
+/**
+ * @class HandTill
+ * @brief The multiclass AUC of Hand and Till (2001), ie. the M-measure.
+ *
+ * The M-measure is the average of the pairwise separabilities,
+ *
+ *   M = 2 / (k(k - 1)) * sum_{i < j} (A(i|j) + A(j|i)) / 2
+ *
+ * where A(i|j) is the probability that a random observation of class i
+ * scores higher in column i than a random observation of class j.
+ *
+ * All k - 1 pairs involving column i are computed in a single descending scan
+ * of that column: every observation of class j adds the weight of class i
+ * observations ranked above it (and half of those tied with it). So each
+ * column is sorted, and scanned, once regardless of the number of pairs.
+ */
+class HandTill {
+    public:
+        /**
+        * Compute the M-measure.
+        *
+        * @param actual   Integer vector of true class labels.
+        * @param response Numeric matrix of predicted scores.
+        * @param ranking  The column-wise descending ordering of `response`.
+        * @param weights  Optional vector of observation weights.
+        * @return         The M-measure; pairs with an empty class are skipped.
+        */
+        static double m_measure(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+            const std::size_t n_classes { static_cast<std::size_t>(levels.size()) };
+
+            if (static_cast<std::size_t>(response.ncol()) != n_classes) {
+                Rcpp::stop("The number of columns in `response` must match the number of levels in `actual`.");
+            }
+
+            const int* ptr_actual { actual.begin() };
+            const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
+
+            // 1) the (weighted) size
+            // of each class
+            std::vector<double> totals(n_classes, 0.0);
+            for (std::size_t i = 0; i < n; i++) {
+                bool valid { ptr_actual[i] >= 1 && static_cast<std::size_t>(ptr_actual[i]) <= n_classes };
+                if (!valid) continue;
+
+                totals[ptr_actual[i] - 1] += (ptr_weights != nullptr) ? ptr_weights[i] : 1.0;
+            }
+
+            // 2) the pairwise separabilities; row c
+            // holds A(c|j) for all classes j
+            std::vector<double> separability(n_classes * n_classes, NA_REAL);
+            double* ptr_separability { separability.data() };
+
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < n_classes; ++c) {
+                if (totals[c] == 0.0) continue;
+
+                conditional_auc(
+                    response, ranking, ptr_actual, ptr_weights, totals,
+                    c, n, n_classes, ptr_separability + c * n_classes
+                );
+            }
+
+            // 3) average over the pairs
+            double sum { 0.0 };
+            std::size_t count { 0 };
+
+            for (std::size_t i = 0; i < n_classes; i++) {
+                for (std::size_t j = i + 1; j < n_classes; j++) {
+                    double a_ij { ptr_separability[i * n_classes + j] };
+                    double a_ji { ptr_separability[j * n_classes + i] };
+
+                    if (!std::isnan(a_ij) && !std::isnan(a_ji)) {
+                        sum += 0.5 * (a_ij + a_ji);
+                        count++;
+                    }
+                }
+            }
+
+            if (count == 0) {
+                return NA_REAL;
+            }
+            return sum / count;
+        }
+
+    private:
+        /**
+        * @brief Compute A(c|j) for all classes j from one scan of column c.
+        *
+        * The scan is in descending order, so the weight of class c observed
+        * before a tied group is the weight ranked strictly above it.
+        *
+        * @param response    Numeric matrix of predicted scores.
+        * @param ranking     The column-wise descending ordering of `response`.
+        * @param ptr_actual  Pointer to the actual class labels.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param totals      The (weighted) size of each class.
+        * @param c           The column (and class) index.
+        * @param n           The number of observations.
+        * @param n_classes   The number of classes.
+        * @param output      Row c of the separability matrix.
+        */
+        static void conditional_auc(
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            const std::vector<double>& totals,
+            std::size_t c,
+            std::size_t n,
+            std::size_t n_classes,
+            double* output)
+        {
+            // 0) declare variables
+            const double* col_ptr { &response(0, c) };
+            const int class_label { static_cast<int>(c + 1) };
+            std::vector<double> numerator(n_classes, 0.0);
+            double above { 0.0 };
+
+            // 1) scan the tied groups
+            for (std::size_t i = 0; i < n; ) {
+                const double score { col_ptr[ranking.row(i, c)] };
+
+                // 1.1) the weight of class c
+                // in the tied group
+                std::size_t j = i;
+                double tied { 0.0 };
+                do {
+                    if (ranking.label(ptr_actual, j, c) == class_label) {
+                        tied += ranking.weight(ptr_weights, j, c);
+                    }
+                    j++;
+                } while (j < n && col_ptr[ranking.row(j, c)] == score);
+
+                // 1.2) each observation of another class
+                // is beaten by the class c weight above it
+                // and ties with the class c weight in the group
+                const double beaten { above + 0.5 * tied };
+                for (std::size_t l = i; l < j; l++) {
+                    const int label { ranking.label(ptr_actual, l, c) };
+                    bool valid { label >= 1 && static_cast<std::size_t>(label) <= n_classes };
+                    if (valid && label != class_label) {
+                        numerator[label - 1] += ranking.weight(ptr_weights, l, c) * beaten;
+                    }
+                }
+
+                above += tied;
+                i = j;
+            }
+
+            // 2) normalize by the
+            // number of pairs
+            for (std::size_t l = 0; l < n_classes; l++) {
+                if (l == c || totals[l] == 0.0) continue;
+                output[l] = numerator[l] / (totals[c] * totals[l]);
+            }
+        }
+
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        HandTill()  = delete;
+        ~HandTill() = delete;
+};
+
+#endif
@@ -0,0 +1,66 @@
+#include "classification_PartialAUC.h"
+
+#include <Rcpp.h>
+#include <string>
+
+using namespace Rcpp;
+
+namespace {
+
+    // the interval is on the TPR-axis
+    // if focus is "tpr"
+    bool tpr_focus(const std::string& focus) {
+        if (focus == "fpr") return false;
+        if (focus == "tpr") return true;
+
+        Rcpp::stop("`focus` must be either \"fpr\" or \"tpr\".");
+    }
+
+}
+
+//' @rdname roc.pauc
+//' @method roc.pauc matrix
+//' @export
+// [[Rcpp::export(roc.pauc.matrix)]]
+Rcpp::NumericVector roc_pauc(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    double lower = 0,
+    double upper = 1,
+    std::string focus = "fpr",
+    bool standardize = false,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const bool tpr { tpr_focus(focus) };
+
+        if (ranking.isNotNull()) {
+            const Ranking ranked { Ranking::adopt(ranking.get(), response, &actual) };
+            return PartialAUC::class_wise(actual, response, lower, upper, tpr, standardize, nullptr, &ranked);
+        }
+
+        return PartialAUC::class_wise(actual, response, lower, upper, tpr, standardize);
+}
+
+//' @rdname roc.pauc
+//' @method weighted.roc.pauc matrix
+//' @export
+// [[Rcpp::export(weighted.roc.pauc.matrix)]]
+Rcpp::NumericVector roc_pauc_weighted(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    const Rcpp::NumericVector w,
+    double lower = 0,
+    double upper = 1,
+    std::string focus = "fpr",
+    bool standardize = false,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const bool tpr { tpr_focus(focus) };
+
+        if (ranking.isNotNull()) {
+            const Ranking ranked { Ranking::adopt(ranking.get(), response, &actual, &w) };
+            return PartialAUC::class_wise(actual, response, lower, upper, tpr, standardize, &w, &ranked);
+        }
+
+        return PartialAUC::class_wise(actual, response, lower, upper, tpr, standardize, &w);
+}
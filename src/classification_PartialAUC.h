@@ -0,0 +1,266 @@
+#ifndef CLASSIFICATION_PARTIALAUC_H
+#define CLASSIFICATION_PARTIALAUC_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cmath>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "utilities_Package.h"
+#include "utilities_Ranking.h"
+
+/**
+ * @class PartialAUC
+ * @brief The partial area under the ROC curve over an FPR or TPR interval.
+ *
+ * Only the top of the ranking is needed when the interval is near the
+ * origin, eg. FPR <= 0.01 in fraud detection. The scan stops as soon as the
+ * curve leaves the interval, and when the data is unweighted, the sort is
+ * replaced by a selection of the prefix that the scan can reach:
+ *
+ *   FPR: P + ceil(upper * N) observations
+ *   TPR: N + ceil(upper * P) observations
+ *
+ * which is partitioned out with std::nth_element and sorted. The remainder is
+ * only sorted if a tied group crosses the end of the prefix.
+ *
+ * The curve is interpolated linearly between the tied groups, so the area
+ * does not depend on the ordering of ties.
+ */
+class PartialAUC {
+    public:
+        /**
+        * Compute the class-wise partial AUC (one-vs-all).
+        *
+        * @param actual      Integer vector of true class labels.
+        * @param response    Numeric matrix of predicted scores.
+        * @param lower       The lower bound of the interval.
+        * @param upper       The upper bound of the interval.
+        * @param tpr         If true the interval is on the TPR-axis, and on the FPR-axis otherwise.
+        * @param standardize If true the area is standardized with the McClish correction.
+        * @param weights     Optional vector of observation weights.
+        * @param ranking     Optional ranking of `response`; if passed nothing is sorted.
+        * @return            A numeric vector of partial AUC values (one per class).
+        */
+        static Rcpp::NumericVector class_wise(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            double lower,
+            double upper,
+            bool tpr = false,
+            bool standardize = false,
+            const Rcpp::NumericVector* weights = nullptr,
+            const Ranking* ranking = nullptr)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+            const std::size_t n_classes { static_cast<std::size_t>(levels.size()) };
+
+            if (!(lower >= 0.0 && upper <= 1.0 && lower < upper)) {
+                Rcpp::stop("The interval must satisfy 0 <= `lower` < `upper` <= 1.");
+            }
+
+            // output container
+            Rcpp::NumericVector output(n_classes);
+            double* ptr_output { output.begin() };
+
+            // pointers to data
+            const int* ptr_actual { actual.begin() };
+            const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
+
+            // 1) compute the partial AUC
+            // for each class
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < n_classes; ++c) {
+
+                // 1.1) count the positives
+                // and negatives
+                int class_label { static_cast<int>(c + 1) };
+                double positives { 0.0 };
+                double negatives { 0.0 };
+
+                for (std::size_t i = 0; i < n; i++) {
+                    double w { (ptr_weights != nullptr) ? ptr_weights[i] : 1.0 };
+                    if (ptr_actual[i] == class_label) {
+                        positives += w;
+                    } else {
+                        negatives += w;
+                    }
+                }
+
+                if (positives == 0.0 || negatives == 0.0) {
+                    ptr_output[c] = NA_REAL;
+                    continue;
+                }
+
+                // 1.2) the ordering; from the ranking
+                // or by (partially) sorting the prefix
+                const double* col_ptr { &response(0, c) };
+                std::vector<int> idx(n);
+                std::size_t sorted { n };
+
+                if (ranking != nullptr) {
+                    for (std::size_t i = 0; i < n; i++) idx[i] = static_cast<int>(ranking->row(i, c));
+                } else {
+                    std::iota(idx.begin(), idx.end(), 0);
+
+                    // 1.2.1) the prefix is only bounded
+                    // by counts, ie. when unweighted
+                    std::size_t prefix { n };
+                    if (ptr_weights == nullptr) {
+                        double bound { tpr ? negatives + std::ceil(upper * positives) : positives + std::ceil(upper * negatives) };
+                        prefix = std::min(n, static_cast<std::size_t>(bound));
+                    }
+
+                    auto descending = [col_ptr](int a, int b) { return col_ptr[a] > col_ptr[b]; };
+                    if (prefix < n) {
+                        std::nth_element(idx.begin(), idx.begin() + prefix, idx.end(), descending);
+                    }
+                    std::sort(idx.begin(), idx.begin() + prefix, descending);
+                    sorted = prefix;
+                }
+
+                // 1.3) scan the curve
+                double area {
+                    partial_area(idx, sorted, col_ptr, ptr_actual, ptr_weights, class_label, positives, negatives, lower, upper, tpr)
+                };
+
+                // 1.4) standardize the area
+                if (standardize) {
+                    double width { upper - lower };
+                    double diagonal { 0.5 * (upper * upper - lower * lower) };
+                    double minimum { tpr ? width - diagonal : diagonal };
+
+                    area = 0.5 * (1.0 + (area - minimum) / (width - minimum));
+                }
+
+                ptr_output[c] = area;
+            }
+
+            // 2) set names attribute
+            output.attr("names") = levels;
+
+            return output;
+        }
+
+    private:
+        /**
+        * @brief Scan the ROC curve of one class until it leaves the interval.
+        *
+        * The points of the curve are the cumulative FPR and TPR after each tied group.
+        * Each segment is clipped to the interval, and its (trapezoidal) area is added;
+        * on the TPR-axis the area is the area to the right of the curve, ie. 1 - FPR.
+        *
+        * @param idx         The ordering of the column; sorted up to `sorted`.
+        * @param sorted      The length of the sorted prefix; idx[sorted] is in place. The rest is sorted if the scan reads past it.
+        * @param col_ptr     Pointer to the column of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param class_label The class label.
+        * @param positives   The total weight of the positives.
+        * @param negatives   The total weight of the negatives.
+        * @param lower       The lower bound of the interval.
+        * @param upper       The upper bound of the interval.
+        * @param tpr         If true the interval is on the TPR-axis.
+        * @return            The partial area.
+        */
+        static double partial_area(
+            std::vector<int>& idx,
+            std::size_t sorted,
+            const double* col_ptr,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            int class_label,
+            double positives,
+            double negatives,
+            double lower,
+            double upper,
+            bool tpr)
+        {
+            // 0) declare variables
+            const std::size_t n { idx.size() };
+            double area { 0.0 };
+            double true_positive { 0.0 };
+            double false_positive { 0.0 };
+            double previous_fpr { 0.0 };
+            double previous_tpr { 0.0 };
+
+            // the remainder is only sorted when the scan
+            // reads past idx[sorted], which is already in
+            // place (and possibly counted); ie. when a tied
+            // group crosses into the remainder, or the scan
+            // continues beyond it
+            auto ensure_sorted = [&](std::size_t j) {
+                if (j > sorted && sorted < n) {
+                    std::sort(idx.begin() + sorted + 1, idx.end(), [col_ptr](int a, int b) { return col_ptr[a] > col_ptr[b]; });
+                    sorted = n;
+                }
+            };
+
+            // 1) scan the tied groups
+            for (std::size_t i = 0; i < n; ) {
+                const double score { col_ptr[idx[i]] };
+
+                std::size_t j = i;
+                do {
+                    double w { (ptr_weights != nullptr) ? ptr_weights[idx[j]] : 1.0 };
+                    if (ptr_actual[idx[j]] == class_label) {
+                        true_positive += w;
+                    } else {
+                        false_positive += w;
+                    }
+                    j++;
+                    ensure_sorted(j);
+                } while (j < n && col_ptr[idx[j]] == score);
+
+                // 1.1) the segment from the previous
+                // point to the current point
+                const double fpr { false_positive / negatives };
+                const double tpr_ { true_positive / positives };
+
+                // 1.2) the axis of the interval (x) and
+                // the height over it (y)
+                const double x0 { tpr ? previous_tpr : previous_fpr };
+                const double x1 { tpr ? tpr_ : fpr };
+                const double y0 { tpr ? 1.0 - previous_fpr : previous_tpr };
+                const double y1 { tpr ? 1.0 - fpr : tpr_ };
+
+                // 1.3) clip the segment to
+                // the interval
+                const double from { std::max(x0, lower) };
+                const double to { std::min(x1, upper) };
+                if (to > from) {
+                    const double slope { (y1 - y0) / (x1 - x0) };
+                    const double y_from { y0 + slope * (from - x0) };
+                    const double y_to { y0 + slope * (to - x0) };
+                    area += 0.5 * (to - from) * (y_from + y_to);
+                }
+
+                previous_fpr = fpr;
+                previous_tpr = tpr_;
+                i = j;
+
+                // 1.4) stop when the curve
+                // leaves the interval
+                if (x1 >= upper) break;
+            }
+
+            return area;
+        }
+
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        PartialAUC()  = delete;
+        ~PartialAUC() = delete;
+};
+
+#endif
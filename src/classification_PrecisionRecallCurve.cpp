@@ -1,4 +1,5 @@
 #include "classification_PrecisionRecallCurve.h"
+#include "classification_BinnedCurve.h"
 
 #include <Rcpp.h>
 
@@ -12,14 +13,17 @@ Rcpp::DataFrame precision_recall_curve(
     const Rcpp::IntegerVector& actual, 
     const Rcpp::NumericMatrix& response,
     Rcpp::Nullable<Rcpp::NumericMatrix> thresholds = R_NilValue,
-    bool presorted = false) {
+    bool presorted = false,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response, presorted) };
         
         if (thresholds.isNotNull()) {
             Rcpp::NumericVector thr = Rcpp::as<Rcpp::NumericVector>(thresholds);
-            return prROC::pr_curve(actual, response, presorted, nullptr, &thr);
+            return prROC::pr_curve(actual, response, ranked, nullptr, &thr);
         }
 
-        return prROC::pr_curve(actual, response, presorted, nullptr, nullptr);
+        return prROC::pr_curve(actual, response, ranked, nullptr, nullptr);
 }
 
 //' @rdname prROC
@@ -31,14 +35,17 @@ Rcpp::DataFrame weighted_precision_recall_curve(
     const Rcpp::NumericMatrix& response, 
     const Rcpp::NumericVector& w, 
     Rcpp::Nullable<Rcpp::NumericVector> thresholds = R_NilValue,
-    bool presorted = false) {
+    bool presorted = false,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual, &w) : Ranking(response, presorted) };
 
         if (thresholds.isNotNull()) {
             Rcpp::NumericVector thr = Rcpp::as<Rcpp::NumericVector>(thresholds);
-            return  prROC::pr_curve(actual, response, presorted, &w, &thr);
+            return  prROC::pr_curve(actual, response, ranked, &w, &thr);
         }
         
-        return  prROC::pr_curve(actual, response, presorted, &w, nullptr);
+        return  prROC::pr_curve(actual, response, ranked, &w, nullptr);
 }
 
 
@@ -50,20 +57,27 @@ Rcpp::NumericVector precision_recall_auc(
     const Rcpp::IntegerVector actual,
     const Rcpp::NumericMatrix response,
     Rcpp::Nullable<bool> micro = R_NilValue,
-    int method = 0) {
+    int method = 0,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue,
+    Rcpp::Nullable<int> bins = R_NilValue) {
 
-        if (micro.isNull()) {
-            return prROC::class_wise(actual, response, method, false);
+        if (bins.isNotNull()) {
+            return BinnedCurve::area_under_curve(actual, response, micro, BinnedCurve::PRECISION_RECALL, Rcpp::as<int>(bins), method, nullptr);
         }
-        
-        bool use_micro = Rcpp::as<bool>(micro);
-        if (use_micro) {
-            double auc = prROC::micro_average(actual, response, method, false);
-            return Rcpp::NumericVector::create(auc);
-        } else {
-            double auc = prROC::macro_average(actual, response, method, false);
+
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response) };
+
+        if (micro.isNotNull() && Rcpp::as<bool>(micro)) {
+            double auc = prROC::micro_average(actual, response, ranked, method);
             return Rcpp::NumericVector::create(auc);
         }
+
+        if (micro.isNull()) {
+            return prROC::class_wise(actual, response, ranked, method);
+        }
+
+        double auc = prROC::macro_average(actual, response, ranked, method);
+        return Rcpp::NumericVector::create(auc);
 }
 
 //' @rdname pr.auc
@@ -75,18 +89,25 @@ Rcpp::NumericVector precision_recall_auc_weighted(
     const Rcpp::NumericMatrix response,
     const Rcpp::NumericVector w,
     Rcpp::Nullable<bool> micro = R_NilValue,
-    int method = 0) {
+    int method = 0,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue,
+    Rcpp::Nullable<int> bins = R_NilValue) {
 
-        if (micro.isNull()) {
-            return prROC::class_wise(actual, response, method, false, &w);
+        if (bins.isNotNull()) {
+            return BinnedCurve::area_under_curve(actual, response, micro, BinnedCurve::PRECISION_RECALL, Rcpp::as<int>(bins), method, &w);
         }
 
-        bool use_micro = Rcpp::as<bool>(micro);
-        if (use_micro) {
-            double auc = prROC::micro_average(actual, response, method, false, &w);
-            return Rcpp::NumericVector::create(auc);
-        } else {
-            double auc = prROC::macro_average(actual, response, method, false, &w);
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual, &w) : Ranking(response) };
+
+        if (micro.isNotNull() && Rcpp::as<bool>(micro)) {
+            double auc = prROC::micro_average(actual, response, ranked, method, &w);
             return Rcpp::NumericVector::create(auc);
         }
-}
\ No newline at end of file
+
+        if (micro.isNull()) {
+            return prROC::class_wise(actual, response, ranked, method, &w);
+        }
+
+        double auc = prROC::macro_average(actual, response, ranked, method, &w);
+        return Rcpp::NumericVector::create(auc);
+}
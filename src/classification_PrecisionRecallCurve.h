@@ -5,13 +5,14 @@
 #include <vector>
 #include <algorithm>
 #include <numeric>
-#include <memory>
 
 #ifdef _OPENMP
   #include <omp.h>
 #endif
 
 #include "utilities_Package.h"
+#include "utilities_Ranking.h"
+#include "utilities_RankingMerge.h"
 
 class prROC {
     public:
@@ -33,6 +34,26 @@ class prROC {
             const Rcpp::NumericMatrix& response,
             int method = TRAPEZOIDAL,
             bool presorted = false,
+            const Rcpp::NumericVector* weights = nullptr) {
+                const Ranking ranking(response, presorted);
+                return class_wise(actual, response, ranking, method, weights);
+            }
+
+        /**
+        * Compute class-wise average precision (AP) for each class from a ranking.
+        *
+        * @param actual   Integer vector of true class labels.
+        * @param response Numeric matrix of predicted scores.
+        * @param ranking  The column-wise descending ordering of `response`.
+        * @param method   Integration method (0 for trapezoidal, nonzero for step).
+        * @param weights  Optional vector of observation weights.
+        * @return         A numeric vector of average precision values (one per class).
+        */
+        static Rcpp::NumericVector class_wise(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            int method = TRAPEZOIDAL,
             const Rcpp::NumericVector* weights = nullptr) {
                 // start of function
 
@@ -42,12 +63,9 @@ class prROC {
                 const R_xlen_t n { actual.size() };
                 const R_xlen_t n_classes { levels.size() };
 
-                // integration method
-                double (*update_area)(double, double, double, double) =
-                    (method == TRAPEZOIDAL) ? trapezoid_area : step_area;
-
                 // output container
                 Rcpp::NumericVector output(n_classes, 0.0);
+                double* ptr_output { output.begin() };
 
                 // pointers to weights (if passed)
                 // and actual values
@@ -62,85 +80,37 @@ class prROC {
                 #endif
                 for (std::size_t c = 0; c < n_classes; ++c) {
 
-                    // 1.1) create smart pointer
-                    // to the sorted values
-                    //
-                    // NOTE: This is a smart pointer - so it deletes
-                    // itself to avoid memory leaks
-                    std::unique_ptr<std::size_t[]> ptr_idx{ prepare_index(response, c, n, presorted) };
-
-                    // 1.2) define class label
+                    // 1.1) define class label
                     // and add one - C++ is 0 indexed, factors are 
                     // are 1 indexed
-                    std::size_t class_label { c + 1 };
+                    int class_label { static_cast<int>(c + 1) };
 
-                    // 1.3) count number
+                    // 1.2) count number
                     // of positives
-                    double positives { count_positives(ptr_actual, ptr_weights, ptr_idx.get(), n, class_label) };
-
-                    // 1.4) declare average precision
-                    // initialized to 0.0 for each class.
-                    double average_precision{ 0.0 };
-
-                    // 1.5) calculate
-                    // average precision
-                    // for each class
+                    double positives {
+                        (ptr_weights != nullptr)
+                            ? count_positives<true>(ranking, ptr_actual, ptr_weights, c, n, class_label)
+                            : count_positives<false>(ranking, ptr_actual, ptr_weights, c, n, class_label)
+                    };
+
+                    // 1.3) if there are no positives
+                    // the average precision is undefined
                     if (positives == 0.0) {
-                        output[c] = NA_REAL;
-                    } else {
-
-                        // 1.5.1) declare and initialize
-                        // auxiliary values used for the 
-                        // calculations
-                        //
-                        // NOTE: recall starts at 0.0, and precision
-                        // starts at 1.0 by convention
-                        double true_positive { 0.0 };
-                        double false_positive { 0.0 };
-                        double previous_recall { 0.0 };
-                        double previous_precision { 1.0 };
-
-                        // 1.5.2) calculate the
-                        // values for each container
-                        for (std::size_t i = 0; i < n; i++) {
-
-                            // 1.5.2.1) extract the
-                            // index pointer, and store
-                            // as idx
-                            std::size_t idx { ptr_idx[i] };
-
-                            // 1.5.2.2) calculate the
-                            // incrementing value
-                            //
-                            // NOTE: if the weightes are passed
-                            // then each true_positive or false_positive gets incremented by
-                            // w_i, ie. the weight at index i. Otherwise it just gets incremented
-                            // by 1.0
-                            double w{(ptr_weights != nullptr) ? ptr_weights[idx] : 1.0};
-                            if (ptr_actual[idx] == class_label) {
-                                true_positive += w;
-                            } else {
-                                false_positive += w;
-                            }
-
-                            // 1.5.2.3) calculate
-                            // recall and precision
-                            // 
-                            // NOTE: There is already a guard
-                            // against 0 positives
-                            double recall { true_positive / positives };
-                            double precision { (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0 };
-                            
-                            // 1.5.2.4) add to average_precision
-                            // container and store the recall and
-                            // prevision for the next iteration.
-                            average_precision += update_area(previous_recall, previous_precision, recall, precision);
-                            previous_recall = recall;
-                            previous_precision = precision;
-                        }
+                        ptr_output[c] = NA_REAL;
+                        continue;
+                    }
 
-                        // 1.6) store in output
-                        output[c] = average_precision;
+                    // 1.4) calculate average precision
+                    // for each class; the scan is specialized
+                    // on weightedness and the integration method
+                    if (ptr_weights != nullptr) {
+                        ptr_output[c] = (method == TRAPEZOIDAL)
+                            ? integrate<true, TRAPEZOIDAL>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives)
+                            : integrate<true, STEP>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives);
+                    } else {
+                        ptr_output[c] = (method == TRAPEZOIDAL)
+                            ? integrate<false, TRAPEZOIDAL>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives)
+                            : integrate<false, STEP>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives);
                     }
                 }
                         
@@ -169,96 +139,68 @@ class prROC {
                 const Rcpp::NumericMatrix& response,
                 int method = TRAPEZOIDAL,
                 bool presorted = false,
+                const Rcpp::NumericVector* weights = nullptr) {
+                    const Ranking ranking(response, presorted);
+                    return micro_average(actual, response, ranking, method, weights);
+            }
+
+            /**
+            * Compute micro-average average precision by pooling all classes from a ranking.
+            *
+            * The pooled n x k scores are never flattened; the sorted columns
+            * of the ranking are merged on the fly (see RankingMerge).
+            *
+            * @param actual    Integer vector of true class labels.
+            * @param response  Numeric matrix of predicted scores.
+            * @param ranking   The column-wise descending ordering of `response`.
+            * @param method    Integration method (0 for trapezoidal, nonzero for step).
+            * @param weights   Optional vector of observation weights.
+            * @return          The micro-average AP.
+            */
+            static double micro_average(
+                const Rcpp::IntegerVector& actual,
+                const Rcpp::NumericMatrix& response,
+                const Ranking& ranking,
+                int method = TRAPEZOIDAL,
                 const Rcpp::NumericVector* weights = nullptr) {
                     // start of function
 
                     // 0) variable declarations
                     // common (fixed) parameters:
-                    const R_xlen_t n { actual.size() };
-                    const R_xlen_t n_classes { response.ncol() };
-
-                    // integration method
-                    double (*update_area)(double, double, double, double) =
-                        (method == TRAPEZOIDAL) ? trapezoid_area : step_area;
-
-                    // output container
-                    Rcpp::NumericVector output(n_classes, 0.0);
+                    const std::size_t n { static_cast<std::size_t>(actual.size()) };
+                    const std::size_t n_classes { static_cast<std::size_t>(response.ncol()) };
 
                     // pointers to weights (if passed)
                     // and actual-values
                     const int* ptr_actual { actual.begin() };
-                    const double* ptr_response { response.begin() };
                     const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
 
-                    // container for aggregating
-                    // true and false positives
-                    std::vector<threshold_container> container(n * n_classes);
-
-                    // variable for aggregating
-                    // positives
+                    // 1) calculate positives; each
+                    // row is positive in (at most) one
+                    // column
                     double positives { 0.0 };
-                    
-                    // 1) flatten response matrix
-                    // by aggregating values for each
-                    // threshold
-                    #ifdef _OPENMP
-                        #pragma omp parallel for if(getUseOpenMP())
-                    #endif
                     for (std::size_t i = 0; i < n; i++) {
-
-                        // 1.1) extract actual
-                        // value (unsorted)
-                        R_xlen_t actual_i { ptr_actual[i] };
-
-                        // 1.2) calculate weight
-                        // NOTE: if weighted the ith index
-                        // of the weights are used. 1.0 otherwise
-                        // (regular counting)
-                        double w { (ptr_weights != nullptr) ? ptr_weights[i] : 1.0 };
-
-                        // 1.3) loop through all
-                        // all classes and populate
-                        // the container
-                        for (std::size_t c = 0; c < n_classes; c++) {
-
-                            // 1.3.1) calculate container
-                            // index
-                            std::size_t idx { i * n_classes + c };
-
-                            // 1.3.2) store values in the
-                            // container by idx
-                            container[idx].score  = *(ptr_response + i + n * c);
-                            container[idx].label  = (actual_i == (c + 1)) ? 1 : 0;
-                            container[idx].weight = w;
-                        }
-                    }
-
-                    // 1.1) sort the container
-                    // in descending order
-                    std::sort(
-                        container.begin(),
-                        container.end(), 
-                        [](const threshold_container &a, const threshold_container &b) { return a.score > b.score;}
-                    );
-
-                    // 2) calculate positives
-                    // in the contaiener
-                    #ifdef _OPENMP
-                        #pragma omp parallel for reduction(+:positives) if(getUseOpenMP())
-                    #endif
-                    for (std::size_t i = 0; i < container.size(); i++) {
-                        if (container[i].label == 1)
-                            positives += container[i].weight;
+                        if (ptr_actual[i] >= 1 && static_cast<std::size_t>(ptr_actual[i]) <= n_classes)
+                            positives += (ptr_weights != nullptr) ? ptr_weights[i] : 1.0;
                     }
 
-                    // 2.1) if there is no
+                    // 1.1) if there is no
                     // positives return NA
                     if (positives == 0.0)
                         return NA_REAL;
 
-                    // 3) calculate (micro) averaged
-                    // precision and return
-                    return compute_average_precision(container, positives, update_area);
+                    // 2) calculate (micro) averaged
+                    // precision from the merged columns
+                    RankingMerge merge(response, ranking);
+                    if (ptr_weights != nullptr) {
+                        return (method == TRAPEZOIDAL)
+                            ? compute_average_precision<true, TRAPEZOIDAL>(merge, ptr_actual, ptr_weights, positives)
+                            : compute_average_precision<true, STEP>(merge, ptr_actual, ptr_weights, positives);
+                    }
+
+                    return (method == TRAPEZOIDAL)
+                        ? compute_average_precision<false, TRAPEZOIDAL>(merge, ptr_actual, ptr_weights, positives)
+                        : compute_average_precision<false, STEP>(merge, ptr_actual, ptr_weights, positives);
                     
                 // end of function
                 }
@@ -278,6 +220,26 @@ class prROC {
                 const Rcpp::NumericMatrix& response,
                 int method = TRAPEZOIDAL,
                 bool presorted = false,
+                const Rcpp::NumericVector* weights = nullptr) {
+                    const Ranking ranking(response, presorted);
+                    return macro_average(actual, response, ranking, method, weights);
+            }
+
+            /**
+            * Compute macro-average average precision from a ranking.
+            *
+            * @param actual    Integer vector of true class labels.
+            * @param response  Numeric matrix of predicted scores.
+            * @param ranking   The column-wise descending ordering of `response`.
+            * @param method    Integration method (0 for trapezoidal, nonzero for step).
+            * @param weights   Optional vector of observation weights.
+            * @return          The macro-average AP.
+            */
+            static double macro_average(
+                const Rcpp::IntegerVector& actual,
+                const Rcpp::NumericMatrix& response,
+                const Ranking& ranking,
+                int method = TRAPEZOIDAL,
                 const Rcpp::NumericVector* weights = nullptr) {
                     // start of function
 
@@ -285,7 +247,7 @@ class prROC {
 
                     // calculate class-wise average
                     // precision (AUC)
-                    Rcpp::NumericVector classwise_average_precision = class_wise(actual, response, method, presorted, weights);
+                    Rcpp::NumericVector classwise_average_precision = class_wise(actual, response, ranking, method, weights);
 
                     // sum and indices count variables
                     double sum { 0.0 };
@@ -325,13 +287,33 @@ class prROC {
             * @param response  Numeric matrix of predicted scores.
             * @param presorted Set to true if each column in response is already sorted.
             * @param weights   Optional vector of observation weights.
-            * @return          A containerFrame with columns: threshold, level, label, recall, and precision.
+            * @return          A containerFrame with columns: threshold, level, label (factor), recall, and precision.
             */
             static Rcpp::DataFrame pr_curve(
                 const Rcpp::IntegerVector& actual,
                 const Rcpp::NumericMatrix& response,
                 bool presorted = false,
                 const Rcpp::NumericVector* weights = nullptr,
+                const Rcpp::NumericVector* thresholds = nullptr) {
+                    const Ranking ranking(response, presorted);
+                    return pr_curve(actual, response, ranking, weights, thresholds);
+            }
+
+            /**
+            * Generate a DataFrame representing the precision-recall curve for all classes from a ranking.
+            *
+            * @param actual     Integer vector of true class labels.
+            * @param response   Numeric matrix of predicted scores.
+            * @param ranking    The column-wise descending ordering of `response`.
+            * @param weights    Optional vector of observation weights.
+            * @param thresholds Optional user-specified vector of threshold values.
+            * @return           A DataFrame with columns: threshold, level, label (factor), recall, and precision.
+            */
+            static Rcpp::DataFrame pr_curve(
+                const Rcpp::IntegerVector& actual,
+                const Rcpp::NumericMatrix& response,
+                const Ranking& ranking,
+                const Rcpp::NumericVector* weights = nullptr,
                 const Rcpp::NumericVector* thresholds = nullptr) {
                     // start of function
 
@@ -355,167 +337,73 @@ class prROC {
                     Rcpp::NumericVector thresholds_vector(total_data_points);
                     Rcpp::NumericVector recall_vector(total_data_points);
                     Rcpp::NumericVector precision_vector(total_data_points);
-                    Rcpp::CharacterVector label_vector(total_data_points);
+                    Rcpp::IntegerVector label_vector(total_data_points);
                     Rcpp::IntegerVector levels_vector(total_data_points);
+
+                    // pointers to the containers
+                    //
+                    // NOTE: all containers are allocated
+                    // before the parallel region, the threads
+                    // only write through these pointers
+                    double* ptr_thresholds_vector { thresholds_vector.begin() };
+                    double* ptr_recall_vector { recall_vector.begin() };
+                    double* ptr_precision_vector { precision_vector.begin() };
+                    int* ptr_label_vector { label_vector.begin() };
+                    int* ptr_levels_vector { levels_vector.begin() };
+
+                    // pointers to the thresholds (if passed)
+                    const double* ptr_thresholds { (thresholds != nullptr) ? thresholds->begin() : nullptr };
+                    const std::size_t n_thresholds { (thresholds != nullptr) ? static_cast<std::size_t>(thresholds->size()) : 0 };
+                    const std::vector<std::size_t> threshold_order { (thresholds != nullptr) ? Ranking::threshold_order(*thresholds) : std::vector<std::size_t>() };
                     
                     // 1) construct the class-wise
                     // precision and recalls
-                    std::size_t idx { 0 };
+                    //
+                    // NOTE: each class c owns the block starting
+                    // at c * data_points_per_class, so the classes
+                    // are filled in parallel
+                    #ifdef _OPENMP
+                        #pragma omp parallel for if(getUseOpenMP())
+                    #endif
                     for (std::size_t c = 0; c < n_classes; ++c) {
 
-                        // 1.1) create smart pointer
-                        // to the sorted values
-                        //
-                        // NOTE: This is a smart pointer - so it deletes
-                        // itself to avoid memory leaks
-                        std::unique_ptr<std::size_t[]> ptr_idx{ prepare_index(response, c, n, presorted) };
-
-                        // 1.2) define class label
+                        // 1.1) define class label
                         // and add one - C++ is 0 indexed, factors are 
                         // are 1 indexed
-                        std::size_t class_label { c + 1 };
-
-                        // 1.3) count number
-                        // of positives
-                        double positives { count_positives(ptr_actual, ptr_weights, ptr_idx.get(), n, class_label) };
-
-                        // 1.4) declare and initialize
-                        // auxiliary values used for the 
-                        // calculations
-                        double true_positive { 0.0 };
-                        double false_positive { 0.0 };
-
-                        // 1.5) calculate values
-                        // conditional on wether
-                        // thresholds are passed
-                        if (thresholds != nullptr) {
-                            // With thresholds; 
-                            // NOTE: the header numbering resets
-                            // in the no-thresholds branch
-
-                            // 1.5.1) initialize
-                            // each vector by class
-                            // by adding arbitrary thresholds 
-                            // and values to ensure pretty precision-recall
-                            // curve
-                            thresholds_vector[idx] = R_PosInf;
-                            recall_vector[idx] = 0.0;
-                            precision_vector[idx] = 1.0;
-                            label_vector[idx] = levels[c];
-                            levels_vector[idx] = class_label;
-
-                            // 1.5.1.1) iterate 
-                            // to the next index 
-                            ++idx;
-
-                            // 1.5.2) loop through
-                            // the thresholds and populate
-                            // the vectors
-                            std::size_t j { 0 };
-                            const double* ptr_thresholds { thresholds->begin() };
-                            for (std::size_t k = 0; k < thresholds->size(); ++k) {
-
-                                // 1.5.2.1) extract the
-                                // ith threshold
-                                double threshold_i { ptr_thresholds[k] };
-
-                                // 1.5.2.2) aggregate
-                                // all values up the the
-                                // ith-threshold
-                                while (j < n && response(ptr_idx.get()[j], c) >= threshold_i) {
-                                    // 1.5.2.2.1) extract
-                                    // the row index
-                                    std::size_t row_idx { ptr_idx.get()[j] };
-
-                                    // 1.5.2.2.2) calculate
-                                    // the weight of the ith row index
-                                    // conditional on weights
-                                    double w { (ptr_weights != nullptr) ? ptr_weights[row_idx] : 1.0 };
-                                    if (ptr_actual[row_idx] == class_label)
-                                        true_positive += w;
-                                    else
-                                        false_positive += w;
-                                    ++j;
-                                }
-
-                                // 1.5.3) populate 
-                                // the vectors and guard
-                                // against zero-division
-                                thresholds_vector[idx] = threshold_i;
-                                recall_vector[idx] = (positives > 0) ? (true_positive / positives) : 0.0;
-                                precision_vector[idx] = (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0;
-                                label_vector[idx] = levels[c];
-                                levels_vector[idx] = class_label;
-
-                                // 1.5.4) increment
-                                // row index
-                                ++idx;
-                            }
-                            
-                            // 1.6) add arbitrary threshold
-                            // values at the end of the
-                            // vectors
-                            thresholds_vector[idx] = R_NegInf;
-                            recall_vector[idx] = 1.0;
-                            precision_vector[idx] = (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0;
-                            label_vector[idx] = levels[c];
-                            levels_vector[idx] = class_label;
-
-                            // 1.6.1) increment to
-                            // next row index
-                            ++idx;
+                        int class_label { static_cast<int>(c + 1) };
+
+                        // 1.1.1) the offset of the
+                        // class block, and the column
+                        // of the response matrix
+                        std::size_t idx { c * static_cast<std::size_t>(data_points_per_class) };
+                        const double* ptr_column { &response(0, c) };
+
+                        // 1.1.2) the level and label
+                        // are constant within the block
+                        std::fill(ptr_levels_vector + idx, ptr_levels_vector + idx + data_points_per_class, class_label);
+                        std::fill(ptr_label_vector + idx, ptr_label_vector + idx + data_points_per_class, class_label);
+
+                        // 1.2) fill the class block; the
+                        // scan is specialized on weightedness
+                        if (ptr_weights != nullptr) {
+                            curve_block<true>(
+                                ranking, ptr_column, ptr_actual, ptr_weights, c, n, class_label, ptr_thresholds, threshold_order.data(), n_thresholds,
+                                ptr_thresholds_vector + idx, ptr_recall_vector + idx, ptr_precision_vector + idx
+                            );
                         } else {
-                            // without thresholds
-
-                            // 1.5.1) iterate through response
-                            // matrix
-                            for (std::size_t i = 0; i <= n; ++i) {
-                                // 1.5.1.1) initialize threshold
-                                // vector with arbitrary threshold if
-                                // at the start of the vector
-                                // TODO: This can probably be done more elegantly. 
-                                if (i == 0) {
-                                    thresholds_vector[idx] = R_PosInf;
-                                } else {
-
-                                    // 1.5.1.1.1) extract
-                                    // row index
-                                    std::size_t row_idx { ptr_idx.get()[i - 1] };
-
-                                    // 1.5.1.1.2) store corresponding
-                                    // response value in the thresholds
-                                    // vector
-                                    thresholds_vector[idx] = response(row_idx, c);
-
-                                    // 1.5.1.1.2) determine
-                                    // the weight value (conditionally)
-                                    // and increment accordingly
-                                    double w { (ptr_weights != nullptr) ? ptr_weights[row_idx] : 1.0 };
-                                    if (ptr_actual[row_idx] == class_label)
-                                        true_positive += w;
-                                    else
-                                        false_positive += w;
-                                }
-
-                                // 1.5.1.2) calculate
-                                // precision and recall
-                                double precision { (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0 };
-                                double recall { (positives > 0) ? (true_positive / positives) : 0.0 };
-                                
-                                // 1.5.1.3) populate
-                                // vectors
-                                precision_vector[idx] = precision;
-                                recall_vector[idx] = recall;
-                                label_vector[idx] = levels[c];
-                                levels_vector[idx] = class_label;
-
-                                // 1.5.1.3) increment
-                                // to next row index
-                                ++idx;
-                            }
+                            curve_block<false>(
+                                ranking, ptr_column, ptr_actual, ptr_weights, c, n, class_label, ptr_thresholds, threshold_order.data(), n_thresholds,
+                                ptr_thresholds_vector + idx, ptr_recall_vector + idx, ptr_precision_vector + idx
+                            );
                         }
                     }
 
+                    // 1.6) the label is the
+                    // level with the levels
+                    // attached, ie. a factor
+                    label_vector.attr("levels") = levels;
+                    label_vector.attr("class") = "factor";
+
                     // 2) construct DataFrame
                     // NOTE: this is where
                     // most memory usage comes
@@ -543,47 +431,89 @@ class prROC {
 
     private:
         /**
-        * @brief Container for storing score information used in precision-recall computations.
+        * @brief Computes the average precision (AP) of class c in one descending scan.
         *
-        * The structure holds a predicted score, a binary label, and a weight for an observation.
-        * It is primarily used to aggregate data for computing micro-average precision by pairing
-        * each score with its corresponding label and weight.
+        * The recall only moves on a positive, so the area is accumulated in
+        * units of the positive weight and divided by the total positive
+        * weight once. The scan is a template on weightedness and on the integration
+        * method, so each combination is compiled into its own branch-free loop
+        * with the integration rule inlined.
         *
-        * @param score
-        *  The predicted score for the observation.
-        * @param label
-        *  The binary label for the observation (1 for positive, 0 for negative).
-        * @param weight
-        *  The weight associated with the observation. Defaults to 1.0 if not specified.
+        * @param ranking     The column-wise descending ordering of the response matrix.
+        * @param ptr_actual  Pointer to an array of actual class labels.
+        * @param ptr_weights Pointer to an array of observation weights (nullptr if unweighted).
+        * @param c           The column (class) of the ranking to process.
+        * @param n           The number of elements (rows) to process.
+        * @param class_label The target class label.
+        * @param positives   The total positive weight of the class.
+        *
+        * @return The average precision.
         */
-        struct threshold_container {
-            double score;  /**< The predicted score for the observation. */
-            int label;     /**< The binary label for the observation: 1 for positive, 0 for negative. */
-            double weight; /**< The weight associated with the observation. */
-        };
-        
+        template <bool weighted, integration_method method>
+        static inline double integrate(
+            const Ranking& ranking,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t c,
+            std::size_t n,
+            int class_label,
+            double positives) {
+
+                // 0) declare variables
+                //
+                // NOTE: precision
+                // starts at 1.0 by convention
+                double output { 0.0 };
+                double true_positive { 0.0 };
+                double false_positive { 0.0 };
+                double previous_precision { 1.0 };
+
+                // 1) compute the area
+                for (std::size_t i = 0; i < n; i++) {
+
+                    // 1.1) the weight of the
+                    // ith ranked row, and its
+                    // positive part
+                    const double w { ranking.weight<weighted>(ptr_weights, i, c) };
+                    const double positive { (ranking.label(ptr_actual, i, c) == class_label) ? w : 0.0 };
+
+                    true_positive  += positive;
+                    false_positive += w - positive;
+
+                    // 1.2) calculate precision and
+                    // add the area of the (unnormalized)
+                    // recall step
+                    const double precision { (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0 };
+                    output += update_area<method>(0.0, previous_precision, positive, precision);
+                    previous_precision = precision;
+                }
+
+                // 2) normalize the
+                // recall
+                return output / positives;
+        }
+
         /**
         * @brief Computes the average precision (AP) using an incremental area update.
         *
         * This function iteratively computes the average precision by aggregating the contributions
-        * from each point in the precision-recall curve. It uses a sorted container of thresholds (and associated
-        * binary labels and weights) to calculate cumulative true positives and false positives. At each step,
-        * the recall and precision are updated, and the incremental area (using the provided integration function)
-        * is added to the overall average precision.
+        * from each point in the precision-recall curve. The scores of all classes are drawn from a
+        * k-way merge of the sorted columns, in descending order. At each step, the precision
+        * is updated, and the incremental area of the recall step is added to the overall average precision.
         *
-        * @param container A vector of threshold_container structures, each holding a thresholds, a binary label (1 for positive, 0 for negative),
-        *                  and a corresponding weight. The container is expected to be sorted in descending order based on the thresholds.
-        * @param positives The total weight of positive instances (true positives) used for normalizing the recall.
-        * @param update_area A pointer to a function that calculates the area between two points on the precision-recall curve.
-        *                    The function should take four parameters: the previous recall, previous precision, current recall,
-        *                    and current precision, and return the incremental area as a double.
+        * @param merge       The merged columns of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels; an entry is positive if its column matches the label.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param positives   The total weight of positive instances (true positives) used for normalizing the recall.
         *
         * @return The computed average precision as a double.
         */
+        template <bool weighted, integration_method method>
         static double compute_average_precision(
-            const std::vector<threshold_container>& container,
-            double positives,
-            double (*update_area)(double, double, double, double)) {
+            RankingMerge& merge,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            double positives) {
 
                 // 0) declare variables
                 // output variable
@@ -594,43 +524,170 @@ class prROC {
                 double true_positive { 0.0 };
                 double false_positive { 0.0 };
 
-                // arbitrary precision and recall
-                // values
-                double previous_recall { 0.0 };
+                // arbitrary precision
+                // value
                 double previous_precision { 0.0 };
+
+                std::size_t row, column;
                 
                 // 1) compute average
                 // precision
-                for (std::size_t i = 0; i < container.size(); i++) {
+                while (!merge.empty()) {
+                    merge.pop(row, column);
 
                     // 1.1) check if label is
-                    // equal to 1
+                    // equal to the column
                     //
                     // NOTE: everything is binarized!
-                    if (container[i].label == 1)
-                        true_positive += container[i].weight;
-                    else
-                        false_positive += container[i].weight;
+                    const double w { weighted ? ptr_weights[row] : 1.0 };
+                    const double positive { (ptr_actual[row] == static_cast<int>(column + 1)) ? w : 0.0 };
+
+                    true_positive  += positive;
+                    false_positive += w - positive;
 
                     // 1.2) calculate precision
-                    // and recall
-                    double recall { true_positive / positives };
-                    double precision { (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0 };
-
-                    // 1.3) add to the total
-                    // area
-                    output += update_area(previous_recall, previous_precision, recall, precision);
-
-                    // 1.4) store current
-                    // precision and recall
-                    // valuues for next iterative
-                    // calculation
-                    previous_recall = recall;
+                    // and add the area of the
+                    // (unnormalized) recall step
+                    const double precision { (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0 };
+                    output += update_area<method>(0.0, previous_precision, positive, precision);
                     previous_precision = precision;
                 }
 
                 // 2) return output
-                return output;
+                return output / positives;
+        }
+
+        /**
+        * @brief Fill the block of class c in the precision-recall curve.
+        *
+        * @param ranking             The column-wise descending ordering of the response matrix.
+        * @param ptr_column          Pointer to column c of the response matrix.
+        * @param ptr_actual          Pointer to the actual class labels.
+        * @param ptr_weights         Pointer to the weights (nullptr if unweighted).
+        * @param c                   The column (class) of the ranking.
+        * @param n                   The number of rows.
+        * @param class_label         The class label (c + 1).
+        * @param ptr_thresholds      Pointer to the user-specified thresholds (nullptr if not passed).
+        * @param ptr_threshold_order The positions of the thresholds in descending order.
+        * @param n_thresholds        The number of user-specified thresholds.
+        * @param out_thresholds      Pointer to the thresholds of the block.
+        * @param out_recall          Pointer to the recall of the block.
+        * @param out_precision       Pointer to the precision of the block.
+        */
+        template <bool weighted>
+        static void curve_block(
+            const Ranking& ranking,
+            const double* ptr_column,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t c,
+            std::size_t n,
+            int class_label,
+            const double* ptr_thresholds,
+            const std::size_t* ptr_threshold_order,
+            std::size_t n_thresholds,
+            double* out_thresholds,
+            double* out_recall,
+            double* out_precision) {
+
+                // 1) count number
+                // of positives
+                const double positives { count_positives<weighted>(ranking, ptr_actual, ptr_weights, c, n, class_label) };
+
+                // 1.1) declare and initialize
+                // auxiliary values used for the 
+                // calculations
+                double true_positive { 0.0 };
+                double false_positive { 0.0 };
+                std::size_t idx { 0 };
+
+                // 1.2) initialize the block
+                // with an arbitrary threshold
+                // to ensure pretty precision-recall
+                // curve
+                out_thresholds[idx] = R_PosInf;
+                out_recall[idx] = 0.0;
+                out_precision[idx] = 1.0;
+                ++idx;
+
+                // 2) with thresholds
+                if (ptr_thresholds != nullptr) {
+
+                    // 2.1) loop through
+                    // the thresholds and populate
+                    // the vectors
+                    //
+                    // NOTE: the thresholds are visited in
+                    // descending order, and each point is
+                    // written to the position of its threshold
+                    std::size_t j { 0 };
+                    for (std::size_t s = 0; s < n_thresholds; ++s) {
+
+                        // 2.1.1) aggregate
+                        // all values up the the
+                        // kth-threshold; the scores
+                        // are only read by the search
+                        const std::size_t k { ptr_threshold_order[s] };
+                        const double threshold_k { ptr_thresholds[k] };
+                        const std::size_t end { ranking.lower_rank(ptr_column, c, j, threshold_k) };
+                        for (; j < end; ++j) {
+                            const double w { ranking.weight<weighted>(ptr_weights, j, c) };
+                            const double positive { (ranking.label(ptr_actual, j, c) == class_label) ? w : 0.0 };
+
+                            true_positive  += positive;
+                            false_positive += w - positive;
+                        }
+
+                        // 2.1.2) populate 
+                        // the vectors and guard
+                        // against zero-division
+                        out_thresholds[idx + k] = threshold_k;
+                        out_recall[idx + k] = (positives > 0) ? (true_positive / positives) : 0.0;
+                        out_precision[idx + k] = (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0;
+                    }
+
+                    // 2.2) add arbitrary threshold
+                    // values at the end of the
+                    // vectors
+                    idx += n_thresholds;
+                    out_thresholds[idx] = R_NegInf;
+                    out_recall[idx] = 1.0;
+                    out_precision[idx] = (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0;
+
+                    return;
+                }
+
+                // 3) without thresholds; iterate
+                // through the ranked column
+                for (std::size_t i = 0; i < n; ++i) {
+                    const double w { ranking.weight<weighted>(ptr_weights, i, c) };
+                    const double positive { (ranking.label(ptr_actual, i, c) == class_label) ? w : 0.0 };
+
+                    true_positive  += positive;
+                    false_positive += w - positive;
+
+                    out_thresholds[idx] = ptr_column[ranking.row(i, c)];
+                    out_precision[idx] = (true_positive + false_positive > 0) ? (true_positive / (true_positive + false_positive)) : 1.0;
+                    out_recall[idx] = (positives > 0) ? (true_positive / positives) : 0.0;
+                    ++idx;
+                }
+        }
+
+        /**
+        * @brief The integration rule of the method, resolved at compile time.
+        */
+        template <integration_method method>
+        static inline double update_area(
+            double x1,
+            double y1,
+            double x2,
+            double y2) {
+
+                if constexpr (method == TRAPEZOIDAL) {
+                    return trapezoid_area(x1, y1, x2, y2);
+                } else {
+                    return step_area(x1, y1, x2, y2);
+                }
         }
 
         /**
@@ -684,80 +741,40 @@ class prROC {
                 return width * y2;
         }
         
-        /**
-        * @brief Prepares a sorted index array for a specified column in a numeric matrix.
-        *
-        * This function creates an array of indices corresponding to the rows of the provided
-        * response matrix and sorts these indices in descending order based on the values
-        * in the specified column. If the column is already presorted (i.e., in descending order),
-        * the function skips the sorting step.
-        *
-        * @param response_matrix The numeric matrix containing predicted scores.
-        * @param column The index of the column to process.
-        * @param n The number of rows in the response matrix.
-        * @param presorted A flag indicating whether the column is already sorted in descending order.
-        *
-        * @return A unique pointer to an array of sorted indices (of type std::size_t).
-        */
-        static inline std::unique_ptr<std::size_t[]> prepare_index(
-            const Rcpp::NumericMatrix& response_matrix,
-            std::size_t column,
-            std::size_t n,
-            bool presorted) {
-
-                // 0) declare variables
-                // smart pointer to indices
-                std::unique_ptr<std::size_t[]> idx(new std::size_t[n]);
-
-                // 1) populate indices
-                // with starting from 0 to n
-                std::iota(idx.get(), idx.get() + n, 0);
-
-                // 2) sort idx by the j'th
-                // column in the response matrix
-                // if not presorted
-                const double* matrix_vector { &response_matrix(0, column) };
-                if (!presorted) {
-                    std::sort(idx.get(), idx.get() + n, [matrix_vector](std::size_t a, std::size_t b) {
-                        return matrix_vector[a] > matrix_vector[b];
-                    });
-                }
-
-                // 3) return values
-                return idx;
-        }
-        
         /**
         * @brief Counts the total positive weight for a given class.
         *
-        * This function iterates over a sorted index array to compute the cumulative weight
-        * of all instances that belong to the specified class. For each index, if the actual
+        * This function iterates over the ranked column c to compute the cumulative weight
+        * of all instances that belong to the specified class. For each rank, if the actual
         * class label matches the target class label, the corresponding weight (if provided)
         * or a default weight of 1.0 is added to the total. This is used to normalize the recall
         * values in precision-recall curve calculations.
         *
+        * @param ranking The column-wise descending ordering of the response matrix.
         * @param ptr_actual Pointer to an array of actual class labels.
         * @param ptr_weights Pointer to an array of observation weights (can be nullptr if weights are not provided).
-        * @param idx A pointer to the sorted index array.
+        * @param c The column (class) of the ranking to process.
         * @param n The number of elements (rows) to process.
         * @param class_label The target class label for which to sum positive weights.
         *
         * @return The total positive weight (or count if unweighted) for the specified class.
         */
+        template <bool weighted>
         static inline double count_positives(
+            const Ranking& ranking,
             const int* ptr_actual,
             const double* ptr_weights,
-            const std::size_t* idx,
+            std::size_t c,
             std::size_t n,
-            std::size_t class_label) {
+            int class_label) {
 
                 // 0) declare values
                 double positives { 0.0 };
                 
                 // 1) count number of positives
                 for (std::size_t i = 0; i < n; i++) {
-                    if (ptr_actual[idx[i]] == class_label)
-                        positives += (ptr_weights != nullptr) ? ptr_weights[idx[i]] : 1.0;
+                    const double w { ranking.weight<weighted>(ptr_weights, i, c) };
+                    positives += (ranking.label(ptr_actual, i, c) == class_label) ? w : 0.0;
                 }
                 
                 // 2) return values
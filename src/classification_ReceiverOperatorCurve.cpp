@@ -1,4 +1,5 @@
 #include "classification_ReceiverOperatorCurve.h"
+#include "classification_BinnedCurve.h"
 
 #include <Rcpp.h>
 
@@ -12,13 +13,16 @@ Rcpp::DataFrame roc_curve_unweighted(
     const Rcpp::IntegerVector actual,
     const Rcpp::NumericMatrix response,
     Rcpp::Nullable<Rcpp::NumericVector> thresholds = R_NilValue,
-    bool presorted = false) {
+    bool presorted = false,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+    const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response, presorted) };
 
     if (thresholds.isNotNull()) {
         Rcpp::NumericVector thr = Rcpp::as<Rcpp::NumericVector>(thresholds);
-        return ROC::roc_curve(actual, response, presorted, nullptr, &thr);
+        return ROC::roc_curve(actual, response, ranked, nullptr, &thr);
     }
-    return ROC::roc_curve(actual, response, presorted, nullptr, nullptr);
+    return ROC::roc_curve(actual, response, ranked, nullptr, nullptr);
 }
 
 //' @rdname ROC
@@ -30,13 +34,84 @@ Rcpp::DataFrame roc_curve_weighted(
     const Rcpp::NumericMatrix response,
     const Rcpp::NumericVector w,
     Rcpp::Nullable<Rcpp::NumericVector> thresholds = R_NilValue,
-    bool presorted = false) {
+    bool presorted = false,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+    const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual, &w) : Ranking(response, presorted) };
+
+    if (thresholds.isNotNull()) {
+        Rcpp::NumericVector thr = Rcpp::as<Rcpp::NumericVector>(thresholds);
+        return ROC::roc_curve(actual, response, ranked, &w, &thr);
+    }
+    return ROC::roc_curve(actual, response, ranked, &w, nullptr);
+}
+
+//' @rdname gain
+//' @method gain factor
+//' @export
+// [[Rcpp::export(gain.factor)]]
+Rcpp::DataFrame gain_curve_unweighted(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    Rcpp::Nullable<Rcpp::NumericVector> thresholds = R_NilValue,
+    bool presorted = false,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+    const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response, presorted) };
 
     if (thresholds.isNotNull()) {
         Rcpp::NumericVector thr = Rcpp::as<Rcpp::NumericVector>(thresholds);
-        return ROC::roc_curve(actual, response, presorted, &w, &thr);
+        return ROC::gain_curve(actual, response, ranked, nullptr, &thr);
     }
-    return ROC::roc_curve(actual, response, presorted, &w, nullptr);
+    return ROC::gain_curve(actual, response, ranked, nullptr, nullptr);
+}
+
+//' @rdname gain
+//' @method weighted.gain factor
+//' @export
+// [[Rcpp::export(weighted.gain.factor)]]
+Rcpp::DataFrame gain_curve_weighted(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    const Rcpp::NumericVector w,
+    Rcpp::Nullable<Rcpp::NumericVector> thresholds = R_NilValue,
+    bool presorted = false,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+    const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual, &w) : Ranking(response, presorted) };
+
+    if (thresholds.isNotNull()) {
+        Rcpp::NumericVector thr = Rcpp::as<Rcpp::NumericVector>(thresholds);
+        return ROC::gain_curve(actual, response, ranked, &w, &thr);
+    }
+    return ROC::gain_curve(actual, response, ranked, &w, nullptr);
+}
+
+//' @rdname roc.ks
+//' @method roc.ks matrix
+//' @export
+// [[Rcpp::export(roc.ks.matrix)]]
+Rcpp::NumericVector roc_ks(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+    const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response) };
+    return ROC::ks_statistic(actual, response, ranked);
+}
+
+//' @rdname roc.ks
+//' @method weighted.roc.ks matrix
+//' @export
+// [[Rcpp::export(weighted.roc.ks.matrix)]]
+Rcpp::NumericVector roc_ks_weighted(
+    const Rcpp::IntegerVector actual,
+    const Rcpp::NumericMatrix response,
+    const Rcpp::NumericVector w,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue) {
+
+    const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual, &w) : Ranking(response) };
+    return ROC::ks_statistic(actual, response, ranked, &w);
 }
 
 
@@ -48,20 +123,27 @@ Rcpp::NumericVector roc_auc(
     const Rcpp::IntegerVector actual,
     const Rcpp::NumericMatrix response,
     Rcpp::Nullable<bool> micro = R_NilValue,
-    int method = 0) {
+    int method = 0,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue,
+    Rcpp::Nullable<int> bins = R_NilValue) {
 
-        if (micro.isNull()) {
-            return ROC::class_wise(actual, response, method, false);
+        if (bins.isNotNull()) {
+            return BinnedCurve::area_under_curve(actual, response, micro, BinnedCurve::RECEIVER_OPERATOR, Rcpp::as<int>(bins), method, nullptr);
         }
-        
-        bool use_micro = Rcpp::as<bool>(micro);
-        if (use_micro) {
-            double auc = ROC::micro_average(actual, response, method, false);
-            return Rcpp::NumericVector::create(auc);
-        } else {
-            double auc = ROC::macro_average(actual, response, method, false);
+
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual) : Ranking(response) };
+
+        if (micro.isNotNull() && Rcpp::as<bool>(micro)) {
+            double auc = ROC::micro_average(actual, response, ranked, method);
             return Rcpp::NumericVector::create(auc);
         }
+
+        if (micro.isNull()) {
+            return ROC::class_wise(actual, response, ranked, method);
+        }
+
+        double auc = ROC::macro_average(actual, response, ranked, method);
+        return Rcpp::NumericVector::create(auc);
 }
 
 //' @rdname roc.auc
@@ -73,18 +155,25 @@ Rcpp::NumericVector roc_auc_weighted(
     const Rcpp::NumericMatrix response,
     const Rcpp::NumericVector w,
     Rcpp::Nullable<bool> micro = R_NilValue,
-    int method = 0) {
+    int method = 0,
+    Rcpp::Nullable<Rcpp::RObject> ranking = R_NilValue,
+    Rcpp::Nullable<int> bins = R_NilValue) {
 
-        if (micro.isNull()) {
-            return ROC::class_wise(actual, response, method, false, &w);
+        if (bins.isNotNull()) {
+            return BinnedCurve::area_under_curve(actual, response, micro, BinnedCurve::RECEIVER_OPERATOR, Rcpp::as<int>(bins), method, &w);
         }
 
-        bool use_micro = Rcpp::as<bool>(micro);
-        if (use_micro) {
-            double auc = ROC::micro_average(actual, response, method, false, &w);
-            return Rcpp::NumericVector::create(auc);
-        } else {
-            double auc = ROC::macro_average(actual, response, method, false, &w);
+        const Ranking ranked { ranking.isNotNull() ? Ranking::adopt(ranking.get(), response, &actual, &w) : Ranking(response) };
+
+        if (micro.isNotNull() && Rcpp::as<bool>(micro)) {
+            double auc = ROC::micro_average(actual, response, ranked, method, &w);
             return Rcpp::NumericVector::create(auc);
         }
-}
\ No newline at end of file
+
+        if (micro.isNull()) {
+            return ROC::class_wise(actual, response, ranked, method, &w);
+        }
+
+        double auc = ROC::macro_average(actual, response, ranked, method, &w);
+        return Rcpp::NumericVector::create(auc);
+}
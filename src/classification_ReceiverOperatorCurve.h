@@ -12,6 +12,8 @@
 #endif
 
 #include "utilities_Package.h"
+#include "utilities_Ranking.h"
+#include "utilities_RankingMerge.h"
 
 /**
  * @class ROC
@@ -20,19 +22,28 @@
  *
  * The class provides:
  *   1) Class-wise AUC (one-vs-all).
- *   2) Micro-average AUC (global flattening).
+ *   2) Micro-average AUC (pooled across classes).
  *   3) Macro-average AUC (average of class-wise AUC).
  *   4) A method to extract the entire ROC curve for each class, returned as an Rcpp::DataFrame.
+ *   5) The cumulative gains, lift and the Kolmogorov-Smirnov statistic from the same scan.
  *
  * Optimizations:
  *   (1) Single pass to count positives and negatives together (instead of two passes).
  *   (2) Parallel sorting of columns when computing class-wise metrics.
  *   (3) Reuse a pre-allocated index array for each column (avoid repeated allocations).
+ *   (4) Every method accepts a Ranking, so a ranking created once in R
+ *       is shared across calls without sorting again.
+ *   (5) The rank method computes the AUC from the midranks (Mann-Whitney) in
+ *       one pass over the tied groups, instead of integrating the curve.
+ *   (6) The micro-average merges the sorted columns of the ranking, instead
+ *       of flattening and sorting all n x k scores.
+ *   (7) The scans are templates on weightedness, so the unweighted and
+ *       weighted loops are compiled separately and carry no per-element branch.
  */
 class ROC {
     public:
         // integration method
-        enum integration_method { TRAPEZOIDAL = 0, STEP };
+        enum integration_method { TRAPEZOIDAL = 0, STEP, RANK };
 
         /**
         * Compute class-wise AUC for each class (one-vs-all).
@@ -55,219 +66,170 @@ class ROC {
             int method = TRAPEZOIDAL,
             bool presorted = false,
             const Rcpp::NumericVector* weights = nullptr) 
+        {
+            // 1) Sort each column (in parallel)
+            const Ranking ranking(response, presorted);
+
+            // 2) Compute the AUC from the ranking
+            return class_wise(actual, response, ranking, method, weights);
+        }
+
+        /**
+        * Compute class-wise AUC for each class (one-vs-all) from a ranking.
+        *
+        * @param actual    Integer vector of true class labels.
+        * @param response  Numeric matrix of predicted scores.
+        * @param ranking   The column-wise descending ordering of `response`.
+        * @param method    Integration method (0 for trapezoidal, 1 for step and 2 for rank). 
+        * @param weights   Optional vector of observation weights.
+        * @return          A numeric vector of AUC values (one per class).
+        */
+        static Rcpp::NumericVector class_wise(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            int method = TRAPEZOIDAL,
+            const Rcpp::NumericVector* weights = nullptr) 
         {
             // 0) variable declarations
             Rcpp::CharacterVector levels = actual.attr("levels");
             const R_xlen_t n { actual.size() };
             const R_xlen_t n_classes { levels.size() };
 
-            // integration method
-            double (*update_area)(double, double, double, double) =
-                (method == TRAPEZOIDAL) ? trapezoid_area : step_area;
-
             // output container
             Rcpp::NumericVector output(n_classes, 0.0);
+            double* ptr_output { output.begin() };
 
             // pointers to data
             const int* ptr_actual { actual.begin() };
             const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
 
-            // 1) Create a pool of index arrays: one array per class
-            //    so we can sort them in parallel without race conditions.
-            std::vector< std::vector<std::size_t> > indices(n_classes, std::vector<std::size_t>(n));
-
-            // 2) Populate and (optionally) parallel-sort
-            #ifdef _OPENMP
-            #pragma omp parallel for if(getUseOpenMP())
-            #endif
-            for (std::size_t c = 0; c < n_classes; c++) {
-                // 2.1) Fill indices[c] with 0..n-1
-                std::iota(indices[c].begin(), indices[c].end(), 0);
-
-                // 2.2) If not presorted, sort this index array
-                if (!presorted) {
-                    const double* col_ptr = &response(0, c); // pointer to column c
-                    std::sort(
-                        indices[c].begin(),
-                        indices[c].end(),
-                        [col_ptr](std::size_t a, std::size_t b) {
-                            return col_ptr[a] > col_ptr[b];
-                        }
-                    );
-                }
-            }
-
-            // 3) Compute the AUC for each class
+            // 1) Compute the AUC for each class
+            //
+            // NOTE: the scans are specialized on
+            // weightedness, so the check is made once
+            // per class instead of once per element.
             #ifdef _OPENMP
             #pragma omp parallel for if(getUseOpenMP())
             #endif
             for (std::size_t c = 0; c < n_classes; ++c) {
 
-                // 3.1) Single pass to count total positives & negatives
+                // 1.1) Single pass to count total positives & negatives
                 //      for class_label c+1
+                int class_label = static_cast<int>(c + 1);
                 double positives { 0.0 };
                 double negatives { 0.0 };
-                {
-                    int class_label = static_cast<int>(c + 1);
-                    const auto& idxRef = indices[c];
-
-                    for (std::size_t i = 0; i < n; i++) {
-                        int actual_i = ptr_actual[idxRef[i]];
-                        double w = (ptr_weights != nullptr) ? ptr_weights[idxRef[i]] : 1.0;
-
-                        if (actual_i == class_label) {
-                            positives += w;
-                        } else {
-                            negatives += w;
-                        }
-                    }
+
+                if (ptr_weights != nullptr) {
+                    count<true>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives, negatives);
+                } else {
+                    count<false>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives, negatives);
                 }
 
-                // 3.2) If no positives or no negatives, AUC is undefined
+                // 1.2) If no positives or no negatives, AUC is undefined
                 if (positives == 0.0 || negatives == 0.0) {
-                    output[c] = NA_REAL;
+                    ptr_output[c] = NA_REAL;
                     continue;
                 }
 
-                // 3.3) Compute AUC using incremental integration
-                double auc = 0.0;
-                double true_positive  { 0.0 };
-                double false_positive { 0.0 };
-
-                double previous_tpr { 0.0 };
-                double previous_fpr { 0.0 };
-
-                int class_label = static_cast<int>(c + 1);
-                const auto& idxRef = indices[c];
-
-                for (std::size_t i = 0; i < n; i++) {
-                    std::size_t row_idx = idxRef[i];
-                    double w = (ptr_weights != nullptr) ? ptr_weights[row_idx] : 1.0;
-
-                    if (ptr_actual[row_idx] == class_label) {
-                        true_positive += w;
-                    } else {
-                        false_positive += w;
-                    }
-
-                    double tpr = true_positive / positives;
-                    double fpr = false_positive / negatives;
-
-                    auc += update_area(previous_fpr, previous_tpr, fpr, tpr);
-
-                    previous_tpr = tpr;
-                    previous_fpr = fpr;
+                // 1.3) Compute AUC from the midranks
+                if (method == RANK) {
+                    ptr_output[c] = (ptr_weights != nullptr)
+                        ? rank_area<true>(ranking, &response(0, c), ptr_actual, ptr_weights, c, n, class_label, positives, negatives)
+                        : rank_area<false>(ranking, &response(0, c), ptr_actual, ptr_weights, c, n, class_label, positives, negatives);
+                    continue;
                 }
 
-                output[c] = auc;
+                // 1.4) Compute AUC using incremental integration
+                ptr_output[c] = (ptr_weights != nullptr)
+                    ? integrate<true>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives, negatives)
+                    : integrate<false>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives, negatives);
             }
 
-            // 4) Assign names to the output
+            // 2) Assign names to the output
             output.attr("names") = levels;
 
-            // 5) Return result
+            // 3) Return result
             return output;
         }
 
         /**
         * Compute micro-average AUC by pooling all classes.
         *
-        * This version also merges passes to count total positives/negatives in a single loop.
-        * We do not have a separate "reuse array" across columns here, because we flatten
-        * the entire matrix into one container. Sorting can still be parallelized if
-        * a parallel sorting routine is used, but standard std::sort is typically serial.
+        * @param actual    Integer vector of true class labels.
+        * @param response  Numeric matrix of predicted scores.
+        * @param method    Integration method (0 for trapezoidal, 1 for step and 2 for rank).
+        * @param presorted Set to true if each column in `response` is already sorted in descending order.
+        * @param weights   Optional vector of observation weights.
+        * @return          The micro-average AUC.
+        */
+        static double micro_average(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            int method = TRAPEZOIDAL,
+            bool presorted = false,
+            const Rcpp::NumericVector* weights = nullptr) 
+        {
+            const Ranking ranking(response, presorted);
+            return micro_average(actual, response, ranking, method, weights);
+        }
+
+        /**
+        * Compute micro-average AUC by pooling all classes from a ranking.
+        *
+        * The pooled n x k scores are never flattened; the sorted columns
+        * of the ranking are merged on the fly (see RankingMerge).
         *
         * @param actual    Integer vector of true class labels.
         * @param response  Numeric matrix of predicted scores.
-        * @param method    Integration method (0 for trapezoidal, nonzero for step).
-        * @param presorted Unused in micro-average because we flatten scores from all columns.
+        * @param ranking   The column-wise descending ordering of `response`.
+        * @param method    Integration method (0 for trapezoidal, 1 for step and 2 for rank).
         * @param weights   Optional vector of observation weights.
         * @return          The micro-average AUC.
         */
         static double micro_average(
             const Rcpp::IntegerVector& actual,
             const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
             int method = TRAPEZOIDAL,
-            bool /* presorted */ = false,
             const Rcpp::NumericVector* weights = nullptr) 
         {
             // 0) variable declarations
-            const R_xlen_t n { actual.size() };
-            const R_xlen_t n_classes { response.ncol() };
-
-            // integration method
-            double (*update_area)(double, double, double, double) =
-                (method == TRAPEZOIDAL) ? trapezoid_area : step_area;
-
-            // Flatten the matrix: we have n * n_classes scores
-            std::vector<threshold_container> container(n * n_classes);
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+            const std::size_t n_classes { static_cast<std::size_t>(response.ncol()) };
 
             const int* ptr_actual { actual.begin() };
-            const double* ptr_response { response.begin() };
             const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
 
-            // 1) Flatten in one pass
-            #ifdef _OPENMP
-                #pragma omp parallel for if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; i++) {
-                double w = (ptr_weights != nullptr) ? ptr_weights[i] : 1.0;
-                int actual_i = ptr_actual[i];
-
-                for (std::size_t c = 0; c < n_classes; c++) {
-                    std::size_t idx = i * n_classes + c;
-
-                    container[idx].score  = *(ptr_response + i + n * c);
-                    container[idx].label  = ((int)(c + 1) == actual_i) ? 1 : 0;
-                    container[idx].weight = w;
-                }
-            }
-
-            // 2) Sort container by descending scores
-            std::sort(
-                container.begin(),
-                container.end(),
-                [](const threshold_container &a, const threshold_container &b) {
-                    return a.score > b.score;
-                }
-            );
-
-            // 3) Single pass to count total positives & negatives
+            // 1) count total positives & negatives;
+            // each row is positive in (at most) one column
+            // and negative in the remaining
             double positives { 0.0 };
             double negatives { 0.0 };
-            for (auto &tc : container) {
-                if (tc.label == 1) {
-                    positives += tc.weight;
-                } else {
-                    negatives += tc.weight;
-                }
+            for (std::size_t i = 0; i < n; i++) {
+                double w { (ptr_weights != nullptr) ? ptr_weights[i] : 1.0 };
+                bool valid { ptr_actual[i] >= 1 && static_cast<std::size_t>(ptr_actual[i]) <= n_classes };
+
+                positives += valid ? w : 0.0;
+                negatives += (valid ? n_classes - 1 : n_classes) * w;
             }
             if (positives == 0.0 || negatives == 0.0) {
                 return NA_REAL;
             }
 
-            // 4) Compute micro-average AUC
-            double auc { 0.0 };
-            double true_positive  { 0.0 };
-            double false_positive { 0.0 };
-            double previous_tpr { 0.0 };
-            double previous_fpr { 0.0 };
+            // 2) merge the sorted columns
+            // and scan the pooled scores
+            RankingMerge merge(response, ranking);
 
-            for (auto &tc : container) {
-                if (tc.label == 1) {
-                    true_positive += tc.weight;
-                } else {
-                    false_positive += tc.weight;
-                }
-                double tpr = true_positive / positives;
-                double fpr = false_positive / negatives;
-
-                auc += update_area(previous_fpr, previous_tpr, fpr, tpr);
-                previous_tpr = tpr;
-                previous_fpr = fpr;
+            if (ptr_weights != nullptr) {
+                return (method == RANK)
+                    ? merged_rank_area<true>(merge, ptr_actual, ptr_weights, positives, negatives)
+                    : merged_area<true>(merge, ptr_actual, ptr_weights, positives, negatives);
             }
 
-            return auc;
+            return (method == RANK)
+                ? merged_rank_area<false>(merge, ptr_actual, ptr_weights, positives, negatives)
+                : merged_area<false>(merge, ptr_actual, ptr_weights, positives, negatives);
         }
 
         /**
@@ -286,10 +248,31 @@ class ROC {
             int method = TRAPEZOIDAL,
             bool presorted = false,
             const Rcpp::NumericVector* weights = nullptr) 
+        {
+            const Ranking ranking(response, presorted);
+            return macro_average(actual, response, ranking, method, weights);
+        }
+
+        /**
+        * Compute macro-average AUC by averaging class-wise AUC from a ranking.
+        *
+        * @param actual    Integer vector of true class labels.
+        * @param response  Numeric matrix of predicted scores.
+        * @param ranking   The column-wise descending ordering of `response`.
+        * @param method    Integration method (0 for trapezoidal, nonzero for step).
+        * @param weights   Optional vector of observation weights.
+        * @return          The macro-average AUC.
+        */
+        static double macro_average(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            int method = TRAPEZOIDAL,
+            const Rcpp::NumericVector* weights = nullptr) 
         {
             // compute class-wise AUC
             Rcpp::NumericVector classwise_auc = class_wise(
-                actual, response, method, presorted, weights);
+                actual, response, ranking, method, weights);
 
             double sum { 0.0 };
             std::size_t count { 0 };
@@ -316,7 +299,7 @@ class ROC {
         * @param weights    Optional vector of observation weights.
         * @param thresholds Optional user-specified vector of threshold values.
         *
-        * @return DataFrame with columns: threshold, level, label, tpr, fpr.
+        * @return DataFrame with columns: threshold, level, label (factor), tpr, fpr.
         */
         static Rcpp::DataFrame roc_curve(
             const Rcpp::IntegerVector& actual,
@@ -324,6 +307,28 @@ class ROC {
             bool presorted = false,
             const Rcpp::NumericVector* weights = nullptr,
             const Rcpp::NumericVector* thresholds = nullptr) 
+        {
+            const Ranking ranking(response, presorted);
+            return roc_curve(actual, response, ranking, weights, thresholds);
+        }
+
+        /**
+        * Generate a DataFrame representing the ROC curve for all classes from a ranking.
+        *
+        * @param actual     Integer vector of true class labels.
+        * @param response   Numeric matrix of predicted scores.
+        * @param ranking    The column-wise descending ordering of `response`.
+        * @param weights    Optional vector of observation weights.
+        * @param thresholds Optional user-specified vector of threshold values.
+        *
+        * @return DataFrame with columns: threshold, level, label (factor), tpr, fpr.
+        */
+        static Rcpp::DataFrame roc_curve(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            const Rcpp::NumericVector* weights = nullptr,
+            const Rcpp::NumericVector* thresholds = nullptr) 
         {
             // 0) variable declarations
             Rcpp::CharacterVector levels = actual.attr("levels");
@@ -342,150 +347,247 @@ class ROC {
             Rcpp::NumericVector thresholds_vector(total_data_points);
             Rcpp::NumericVector tpr_vector(total_data_points);
             Rcpp::NumericVector fpr_vector(total_data_points);
-            Rcpp::CharacterVector label_vector(total_data_points);
+            Rcpp::IntegerVector label_vector(total_data_points);
             Rcpp::IntegerVector levels_vector(total_data_points);
 
-            // we again reuse an index pool
-            std::vector< std::vector<std::size_t> > indices(n_classes, std::vector<std::size_t>(n));
-
-            // 1) Prepare sorted indices for each column (possibly in parallel)
+            // raw pointers to the output containers
+            //
+            // NOTE: the containers are allocated up front so
+            // the threads below only write through these pointers
+            // and never touch the R API.
+            double* ptr_thresholds_vector { thresholds_vector.begin() };
+            double* ptr_tpr_vector { tpr_vector.begin() };
+            double* ptr_fpr_vector { fpr_vector.begin() };
+            int* ptr_label_vector { label_vector.begin() };
+            int* ptr_levels_vector { levels_vector.begin() };
+
+            const double* ptr_thresholds { (thresholds != nullptr) ? thresholds->begin() : nullptr };
+            const std::size_t n_thresholds { (thresholds != nullptr) ? static_cast<std::size_t>(thresholds->size()) : 0 };
+            const std::vector<std::size_t> threshold_order { (thresholds != nullptr) ? Ranking::threshold_order(*thresholds) : std::vector<std::size_t>() };
+
+            // 1) Build the ROC curve
+            //
+            // NOTE: each class owns the block starting at
+            // c * data_points_per_class, so the classes
+            // can be filled in parallel without any
+            // synchronization.
             #ifdef _OPENMP
             #pragma omp parallel for if(getUseOpenMP())
             #endif
-            for (std::size_t c = 0; c < n_classes; c++) {
-                std::iota(indices[c].begin(), indices[c].end(), 0);
-                if (!presorted) {
-                    const double* col_ptr = &response(0, c);
-                    std::sort(
-                        indices[c].begin(),
-                        indices[c].end(),
-                        [col_ptr](std::size_t a, std::size_t b) {
-                            return col_ptr[a] > col_ptr[b];
-                        }
-                    );
+            for (std::size_t c = 0; c < n_classes; ++c) {
+
+                // offset of the class block
+                std::size_t idx { c * static_cast<std::size_t>(data_points_per_class) };
+
+                const double* col_ptr = &response(0, c);
+                int class_label = static_cast<int>(c + 1);
+
+                // the level and label columns are
+                // constant within the class block
+                std::fill(ptr_levels_vector + idx, ptr_levels_vector + idx + data_points_per_class, class_label);
+                std::fill(ptr_label_vector + idx, ptr_label_vector + idx + data_points_per_class, class_label);
+
+                // fill the class block; specialized
+                // on weightedness
+                auto emit = [&](std::size_t i, double threshold, double true_positive, double false_positive, double positives, double negatives) {
+                    ptr_thresholds_vector[idx + i] = threshold;
+                    ptr_tpr_vector[idx + i] = (positives > 0.0) ? (true_positive / positives) : 0.0;
+                    ptr_fpr_vector[idx + i] = (negatives > 0.0) ? (false_positive / negatives) : 0.0;
+                };
+
+                if (ptr_weights != nullptr) {
+                    curve_block<true>(ranking, col_ptr, ptr_actual, ptr_weights, c, n, class_label, ptr_thresholds, threshold_order.data(), n_thresholds, emit);
+                } else {
+                    curve_block<false>(ranking, col_ptr, ptr_actual, ptr_weights, c, n, class_label, ptr_thresholds, threshold_order.data(), n_thresholds, emit);
                 }
             }
 
-            // 2) Build the ROC curve
-            std::size_t idx { 0 };
+            // 1.3) The label column is the
+            // level column with the levels attached, ie. a factor
+            label_vector.attr("levels") = levels;
+            label_vector.attr("class")  = "factor";
 
-            for (std::size_t c = 0; c < n_classes; ++c) {
+            // 2) Construct the DataFrame
+            Rcpp::DataFrame output = Rcpp::DataFrame::create(
+                Rcpp::Named("threshold") = thresholds_vector,
+                Rcpp::Named("level")     = levels_vector,
+                Rcpp::Named("label")     = label_vector,
+                Rcpp::Named("tpr")       = tpr_vector,
+                Rcpp::Named("fpr")       = fpr_vector
+            );
+            output.attr("class") = Rcpp::CharacterVector::create("ROC", "data.frame");
 
-                // single pass to count total positives & negatives
-                double positives { 0.0 };
-                double negatives { 0.0 };
-                {
-                    int class_label = static_cast<int>(c + 1);
-                    const auto& idxRef = indices[c];
-                    for (std::size_t i = 0; i < n; i++) {
-                        double w = (ptr_weights != nullptr) ? ptr_weights[idxRef[i]] : 1.0;
-                        if (ptr_actual[idxRef[i]] == class_label) {
-                            positives += w;
-                        } else {
-                            negatives += w;
-                        }
-                    }
-                }
+            return output;
+        }
 
-                double true_positive { 0.0 };
-                double false_positive { 0.0 };
-
-                if (thresholds != nullptr) {
-                    // 2.1) With user-provided thresholds
-
-                    // start with +Inf => TPR=0, FPR=0
-                    thresholds_vector[idx] = R_PosInf;
-                    tpr_vector[idx] = 0.0;
-                    fpr_vector[idx] = 0.0;
-                    label_vector[idx] = levels[c];
-                    levels_vector[idx] = (int)(c + 1);
-                    ++idx;
-
-                    const double* ptr_thresholds = thresholds->begin();
-                    std::size_t j { 0 };
-                    const auto& idxRef = indices[c];
-                    int class_label = (int)(c + 1);
-
-                    for (std::size_t k = 0; k < thresholds->size(); ++k) {
-                        double threshold_k = ptr_thresholds[k];
-
-                        // move j while score >= threshold_k
-                        while (j < (std::size_t)n &&
-                               response(idxRef[j], c) >= threshold_k) 
-                        {
-                            double w = (ptr_weights != nullptr) ? ptr_weights[idxRef[j]] : 1.0;
-                            if (ptr_actual[idxRef[j]] == class_label) {
-                                true_positive += w;
-                            } else {
-                                false_positive += w;
-                            }
-                            ++j;
-                        }
-
-                        double tpr = (positives > 0.0) ? (true_positive / positives) : 0.0;
-                        double fpr = (negatives > 0.0) ? (false_positive / negatives) : 0.0;
-
-                        thresholds_vector[idx] = threshold_k;
-                        tpr_vector[idx] = tpr;
-                        fpr_vector[idx] = fpr;
-                        label_vector[idx] = levels[c];
-                        levels_vector[idx] = class_label;
-                        ++idx;
-                    }
+        /**
+        * Generate a DataFrame of the cumulative gains for all classes from a ranking.
+        *
+        * The gains are read off the same scan as the ROC curve; at each threshold the
+        * targeted share of the population (depth), the share of the positives
+        * captured (gain), the gain relative to random targeting (lift) and the
+        * share of positives among the targeted (cumulative response) are stored.
+        *
+        * @param actual     Integer vector of true class labels.
+        * @param response   Numeric matrix of predicted scores.
+        * @param ranking    The column-wise descending ordering of `response`.
+        * @param weights    Optional vector of observation weights.
+        * @param thresholds Optional user-specified vector of threshold values.
+        *
+        * @return DataFrame with columns: threshold, level, label (factor), depth, gain, lift, response.
+        */
+        static Rcpp::DataFrame gain_curve(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            const Rcpp::NumericVector* weights = nullptr,
+            const Rcpp::NumericVector* thresholds = nullptr)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const R_xlen_t n { response.nrow() };
+            const R_xlen_t n_classes { response.ncol() };
 
-                    // end with -Inf => TPR=1, FPR=1 (if positives/negatives > 0)
-                    thresholds_vector[idx] = R_NegInf;
-                    double tpr = (positives > 0.0) ? (true_positive / positives) : 0.0;
-                    double fpr = (negatives > 0.0) ? (false_positive / negatives) : 0.0;
-                    tpr_vector[idx] = tpr;
-                    fpr_vector[idx] = fpr;
-                    label_vector[idx] = levels[c];
-                    levels_vector[idx] = class_label;
-                    ++idx;
+            const R_xlen_t data_points_per_class {
+                (thresholds != nullptr) ? thresholds->size() + 2 : (n + 1)
+            };
+            const R_xlen_t total_data_points = data_points_per_class * n_classes;
+
+            const int* ptr_actual { actual.begin() };
+            const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
+
+            // output containers
+            Rcpp::NumericVector thresholds_vector(total_data_points);
+            Rcpp::NumericVector depth_vector(total_data_points);
+            Rcpp::NumericVector gain_vector(total_data_points);
+            Rcpp::NumericVector lift_vector(total_data_points);
+            Rcpp::NumericVector response_vector(total_data_points);
+            Rcpp::IntegerVector label_vector(total_data_points);
+            Rcpp::IntegerVector levels_vector(total_data_points);
+
+            double* ptr_thresholds_vector { thresholds_vector.begin() };
+            double* ptr_depth_vector { depth_vector.begin() };
+            double* ptr_gain_vector { gain_vector.begin() };
+            double* ptr_lift_vector { lift_vector.begin() };
+            double* ptr_response_vector { response_vector.begin() };
+            int* ptr_label_vector { label_vector.begin() };
+            int* ptr_levels_vector { levels_vector.begin() };
 
+            const double* ptr_thresholds { (thresholds != nullptr) ? thresholds->begin() : nullptr };
+            const std::size_t n_thresholds { (thresholds != nullptr) ? static_cast<std::size_t>(thresholds->size()) : 0 };
+            const std::vector<std::size_t> threshold_order { (thresholds != nullptr) ? Ranking::threshold_order(*thresholds) : std::vector<std::size_t>() };
+
+            // 1) Build the gains; each class
+            // owns its block as in roc_curve
+            #ifdef _OPENMP
+            #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < n_classes; ++c) {
+
+                // offset of the class block
+                std::size_t idx { c * static_cast<std::size_t>(data_points_per_class) };
+
+                const double* col_ptr = &response(0, c);
+                int class_label = static_cast<int>(c + 1);
+
+                std::fill(ptr_levels_vector + idx, ptr_levels_vector + idx + data_points_per_class, class_label);
+                std::fill(ptr_label_vector + idx, ptr_label_vector + idx + data_points_per_class, class_label);
+
+                // the lift and the cumulative response
+                // are undefined before anything is targeted
+                auto emit = [&](std::size_t i, double threshold, double true_positive, double false_positive, double positives, double negatives) {
+                    const double targeted { true_positive + false_positive };
+                    const double depth { (positives + negatives > 0.0) ? targeted / (positives + negatives) : 0.0 };
+                    const double gain { (positives > 0.0) ? true_positive / positives : 0.0 };
+
+                    ptr_thresholds_vector[idx + i] = threshold;
+                    ptr_depth_vector[idx + i] = depth;
+                    ptr_gain_vector[idx + i] = gain;
+                    ptr_lift_vector[idx + i] = (depth > 0.0 && positives > 0.0) ? gain / depth : NA_REAL;
+                    ptr_response_vector[idx + i] = (targeted > 0.0) ? true_positive / targeted : NA_REAL;
+                };
+
+                if (ptr_weights != nullptr) {
+                    curve_block<true>(ranking, col_ptr, ptr_actual, ptr_weights, c, n, class_label, ptr_thresholds, threshold_order.data(), n_thresholds, emit);
                 } else {
-                    // 2.2) Without user-provided thresholds
-                    //      we add (n+1) points from +Inf down to last score
-
-                    const auto& idxRef = indices[c];
-                    int class_label = (int)(c + 1);
-
-                    for (std::size_t i = 0; i <= (std::size_t)n; i++) {
-                        if (i == 0) {
-                            thresholds_vector[idx] = R_PosInf;
-                        } else {
-                            std::size_t row_idx = idxRef[i - 1];
-                            thresholds_vector[idx] = response(row_idx, c);
-
-                            double w = (ptr_weights != nullptr) ? ptr_weights[row_idx] : 1.0;
-                            if (ptr_actual[row_idx] == class_label) {
-                                true_positive += w;
-                            } else {
-                                false_positive += w;
-                            }
-                        }
-
-                        double tpr = (positives > 0.0) ? (true_positive / positives) : 0.0;
-                        double fpr = (negatives > 0.0) ? (false_positive / negatives) : 0.0;
-
-                        tpr_vector[idx] = tpr;
-                        fpr_vector[idx] = fpr;
-                        label_vector[idx] = levels[c];
-                        levels_vector[idx] = class_label;
-                        ++idx;
-                    }
+                    curve_block<false>(ranking, col_ptr, ptr_actual, ptr_weights, c, n, class_label, ptr_thresholds, threshold_order.data(), n_thresholds, emit);
                 }
             }
 
-            // 3) Construct the DataFrame
+            // 1.1) The label column is the
+            // level column with the levels attached, ie. a factor
+            label_vector.attr("levels") = levels;
+            label_vector.attr("class")  = "factor";
+
+            // 2) Construct the DataFrame
             Rcpp::DataFrame output = Rcpp::DataFrame::create(
                 Rcpp::Named("threshold") = thresholds_vector,
                 Rcpp::Named("level")     = levels_vector,
                 Rcpp::Named("label")     = label_vector,
-                Rcpp::Named("tpr")       = tpr_vector,
-                Rcpp::Named("fpr")       = fpr_vector
+                Rcpp::Named("depth")     = depth_vector,
+                Rcpp::Named("gain")      = gain_vector,
+                Rcpp::Named("lift")      = lift_vector,
+                Rcpp::Named("response")  = response_vector
             );
-            output.attr("class") = Rcpp::CharacterVector::create("ROC", "data.frame");
+            output.attr("class") = Rcpp::CharacterVector::create("gain", "data.frame");
+
+            return output;
+        }
+
+        /**
+        * Compute the Kolmogorov-Smirnov statistic, max(TPR - FPR), for each class from a ranking.
+        *
+        * The statistic is only evaluated between tied groups, ie. at thresholds that
+        * can be realised, and the threshold of the maximum is returned in the
+        * `threshold`-attribute.
+        *
+        * @param actual    Integer vector of true class labels.
+        * @param response  Numeric matrix of predicted scores.
+        * @param ranking   The column-wise descending ordering of `response`.
+        * @param weights   Optional vector of observation weights.
+        * @return          A named numeric vector of the statistics (one per class).
+        */
+        static Rcpp::NumericVector ks_statistic(
+            const Rcpp::IntegerVector& actual,
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            // 0) variable declarations
+            Rcpp::CharacterVector levels = actual.attr("levels");
+            const std::size_t n { static_cast<std::size_t>(response.nrow()) };
+            const std::size_t n_classes { static_cast<std::size_t>(levels.size()) };
+
+            if (static_cast<std::size_t>(response.ncol()) != n_classes) {
+                Rcpp::stop("The number of columns in `response` must match the number of levels in `actual`.");
+            }
+
+            Rcpp::NumericVector output(n_classes);
+            Rcpp::NumericVector cutoff(n_classes);
+            double* ptr_output { output.begin() };
+            double* ptr_cutoff { cutoff.begin() };
+
+            const int* ptr_actual { actual.begin() };
+            const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
+
+            // 1) scan each class
+            #ifdef _OPENMP
+            #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < n_classes; ++c) {
+                const int class_label { static_cast<int>(c + 1) };
+
+                if (ptr_weights != nullptr) {
+                    ks_block<true>(ranking, &response(0, c), ptr_actual, ptr_weights, c, n, class_label, ptr_output[c], ptr_cutoff[c]);
+                } else {
+                    ks_block<false>(ranking, &response(0, c), ptr_actual, ptr_weights, c, n, class_label, ptr_output[c], ptr_cutoff[c]);
+                }
+            }
+
+            // 2) Assign names to the output
+            output.attr("names") = levels;
+            cutoff.attr("names") = levels;
+            output.attr("threshold") = cutoff;
 
             return output;
         }
@@ -493,51 +595,385 @@ class ROC {
 
     private:
         /**
-        * @brief Container for storing score/label/weight, used primarily for micro-average.
+        * @brief Count the total positive and negative weight of class c.
+        *
+        * @param ranking     The column-wise descending ordering of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param c           The column (class) of the ranking.
+        * @param n           The number of rows.
+        * @param class_label The class label (c + 1).
+        * @param positives   Output; the total weight of the positives.
+        * @param negatives   Output; the total weight of the negatives.
+        */
+        template <bool weighted>
+        static inline void count(
+            const Ranking& ranking,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t c,
+            std::size_t n,
+            int class_label,
+            double& positives,
+            double& negatives)
+        {
+            double p { 0.0 };
+            double q { 0.0 };
+
+            for (std::size_t i = 0; i < n; i++) {
+                const double w { ranking.weight<weighted>(ptr_weights, i, c) };
+                const bool positive { ranking.label(ptr_actual, i, c) == class_label };
+
+                p += positive ? w : 0.0;
+                q += positive ? 0.0 : w;
+            }
+
+            positives = p;
+            negatives = q;
+        }
+
+        /**
+        * @brief Integrate the ROC curve of class c in one descending scan.
+        *
+        * Each observation moves the curve either up (a positive) or right
+        * (a negative), so the trapezoidal and the step rule add the same
+        * rectangle, w * TP, for every negative. The area is accumulated in
+        * unnormalized units and divided by P * N once, ie.
+        *
+        *   AUC = sum_{negatives} w_i * TP_i / (P * N)
+        *
+        * which leaves a branch-free loop without divisions.
+        *
+        * @param ranking     The column-wise descending ordering of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param c           The column (class) of the ranking.
+        * @param n           The number of rows.
+        * @param class_label The class label (c + 1).
+        * @param positives   The total weight of the positives.
+        * @param negatives   The total weight of the negatives.
+        * @return            The AUC.
+        */
+        template <bool weighted>
+        static inline double integrate(
+            const Ranking& ranking,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t c,
+            std::size_t n,
+            int class_label,
+            double positives,
+            double negatives)
+        {
+            double area { 0.0 };
+            double true_positive { 0.0 };
+
+            for (std::size_t i = 0; i < n; i++) {
+                const double w { ranking.weight<weighted>(ptr_weights, i, c) };
+                const double positive { (ranking.label(ptr_actual, i, c) == class_label) ? w : 0.0 };
+
+                true_positive += positive;
+                area += (w - positive) * true_positive;
+            }
+
+            return area / (positives * negatives);
+        }
+
+        /**
+        * @brief Integrate the pooled ROC curve from the merged columns.
+        *
+        * @param merge       The merged columns of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels; an entry is positive if its column matches the label.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param positives   The total weight of the positives.
+        * @param negatives   The total weight of the negatives.
+        * @return            The micro-average AUC.
         */
-        struct threshold_container {
-            double score;
-            int label;
-            double weight;
-        };
+        template <bool weighted>
+        static double merged_area(
+            RankingMerge& merge,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            double positives,
+            double negatives)
+        {
+            double area { 0.0 };
+            double true_positive { 0.0 };
+            std::size_t row, column;
+
+            while (!merge.empty()) {
+                merge.pop(row, column);
+
+                const double w { weighted ? ptr_weights[row] : 1.0 };
+                const double positive { (ptr_actual[row] == static_cast<int>(column + 1)) ? w : 0.0 };
+
+                true_positive += positive;
+                area += (w - positive) * true_positive;
+            }
+
+            return area / (positives * negatives);
+        }
 
         /**
-        * @brief Compute area increment using the trapezoidal rule.
+        * @brief Compute the pooled AUC from the midranks of the merged columns.
         *
-        * @param x1 The FPR at the previous point.
-        * @param y1 The TPR at the previous point.
-        * @param x2 The FPR at the current point.
-        * @param y2 The TPR at the current point.
-        * @return   The incremental area under the TPR-FPR curve.
+        * @param merge       The merged columns of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels; an entry is positive if its column matches the label.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param positives   The total weight of the positives.
+        * @param negatives   The total weight of the negatives.
+        * @return            The micro-average AUC.
         */
-        static inline double trapezoid_area(
-            double x1,
-            double y1,
-            double x2,
-            double y2) 
+        template <bool weighted>
+        static double merged_rank_area(
+            RankingMerge& merge,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            double positives,
+            double negatives)
         {
-            double width  = (x2 - x1);
-            double height = 0.5 * (y1 + y2);
-            return width * height;
+            double area { 0.0 };
+            double negatives_above { 0.0 };
+            std::size_t row, column;
+
+            while (!merge.empty()) {
+                double group_positives { 0.0 };
+                double group_negatives { 0.0 };
+                const double score { merge.peek() };
+
+                do {
+                    merge.pop(row, column);
+
+                    const double w { weighted ? ptr_weights[row] : 1.0 };
+                    const double positive { (ptr_actual[row] == static_cast<int>(column + 1)) ? w : 0.0 };
+
+                    group_positives += positive;
+                    group_negatives += w - positive;
+                } while (!merge.empty() && merge.peek() == score);
+
+                area += group_positives * (negatives - negatives_above - 0.5 * group_negatives);
+                negatives_above += group_negatives;
+            }
+
+            return area / (positives * negatives);
         }
 
         /**
-        * @brief Compute area increment using the step method (no interpolation).
+        * @brief Scan the block of class c of a curve.
         *
-        * @param x1 The FPR at the previous point.
-        * @param y1 The TPR at the previous point (unused in final calc).
-        * @param x2 The FPR at the current point.
-        * @param y2 The TPR at the current point.
-        * @return   The incremental area under the curve.
+        * The scan visits the +Inf threshold, every score (or every user-specified
+        * threshold, and -Inf) in descending order, and passes the cumulative
+        * weights to `emit` as,
+        *
+        *   emit(idx, threshold, true_positive, false_positive, positives, negatives)
+        *
+        * so the ROC curve and the cumulative gains are different views
+        * of the same scan. The user-specified thresholds can be in any order;
+        * the point of the k'th threshold is emitted at idx = k + 1.
+        *
+        * @param ranking             The column-wise descending ordering of the response matrix.
+        * @param col_ptr             Pointer to column c of the response matrix.
+        * @param ptr_actual          Pointer to the actual class labels.
+        * @param ptr_weights         Pointer to the weights (nullptr if unweighted).
+        * @param c                   The column (class) of the ranking.
+        * @param n                   The number of rows.
+        * @param class_label         The class label (c + 1).
+        * @param ptr_thresholds      Pointer to the user-specified thresholds (nullptr if not passed).
+        * @param ptr_threshold_order The positions of the thresholds in descending order.
+        * @param n_thresholds        The number of user-specified thresholds.
+        * @param emit                Writes the point at offset idx of the block.
         */
-        static inline double step_area(
-            double x1,
-            double /*y1*/,
-            double x2,
-            double y2) 
+        template <bool weighted, typename Emit>
+        static void curve_block(
+            const Ranking& ranking,
+            const double* col_ptr,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t c,
+            std::size_t n,
+            int class_label,
+            const double* ptr_thresholds,
+            const std::size_t* ptr_threshold_order,
+            std::size_t n_thresholds,
+            Emit&& emit)
         {
-            double width = (x2 - x1);
-            return width * y2;
+            // single pass to count total positives & negatives
+            double positives { 0.0 };
+            double negatives { 0.0 };
+            count<weighted>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives, negatives);
+
+            double true_positive { 0.0 };
+            double false_positive { 0.0 };
+            std::size_t idx { 0 };
+
+            // start with +Inf => TPR=0, FPR=0
+            emit(idx++, R_PosInf, true_positive, false_positive, positives, negatives);
+
+            if (ptr_thresholds != nullptr) {
+                // 1.1) With user-provided thresholds; visited
+                //      in descending order, and each point is
+                //      written to the position of its threshold
+                std::size_t j { 0 };
+
+                for (std::size_t s = 0; s < n_thresholds; ++s) {
+                    const std::size_t k { ptr_threshold_order[s] };
+                    const double threshold_k { ptr_thresholds[k] };
+
+                    // add the scores >= threshold_k; the
+                    // scores are only read by the search
+                    const std::size_t end { ranking.lower_rank(col_ptr, c, j, threshold_k) };
+                    for (; j < end; ++j) {
+                        const double w { ranking.weight<weighted>(ptr_weights, j, c) };
+                        const double positive { (ranking.label(ptr_actual, j, c) == class_label) ? w : 0.0 };
+
+                        true_positive  += positive;
+                        false_positive += w - positive;
+                    }
+
+                    emit(idx + k, threshold_k, true_positive, false_positive, positives, negatives);
+                }
+
+                // end with -Inf
+                emit(idx + n_thresholds, R_NegInf, true_positive, false_positive, positives, negatives);
+
+                return;
+            }
+
+            // 1.2) Without user-provided thresholds
+            //      we add (n+1) points from +Inf down to last score
+            for (std::size_t i = 0; i < n; i++) {
+                const double w { ranking.weight<weighted>(ptr_weights, i, c) };
+                const double positive { (ranking.label(ptr_actual, i, c) == class_label) ? w : 0.0 };
+
+                true_positive  += positive;
+                false_positive += w - positive;
+
+                emit(idx++, col_ptr[ranking.row(i, c)], true_positive, false_positive, positives, negatives);
+            }
+        }
+
+        /**
+        * @brief Compute max(TPR - FPR) of class c over the tied groups.
+        *
+        * @param ranking     The column-wise descending ordering of the response matrix.
+        * @param col_ptr     Pointer to column c of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param c           The column (class) of the ranking.
+        * @param n           The number of rows.
+        * @param class_label The class label (c + 1).
+        * @param statistic   Output; the statistic, NA if the class has no positives or negatives.
+        * @param threshold   Output; the threshold of the maximum.
+        */
+        template <bool weighted>
+        static void ks_block(
+            const Ranking& ranking,
+            const double* col_ptr,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t c,
+            std::size_t n,
+            int class_label,
+            double& statistic,
+            double& threshold)
+        {
+            double positives { 0.0 };
+            double negatives { 0.0 };
+            count<weighted>(ranking, ptr_actual, ptr_weights, c, n, class_label, positives, negatives);
+
+            if (positives == 0.0 || negatives == 0.0) {
+                statistic = NA_REAL;
+                threshold = NA_REAL;
+                return;
+            }
+
+            // the curve starts at (0, 0)
+            // at the +Inf threshold
+            double true_positive { 0.0 };
+            double false_positive { 0.0 };
+            statistic = 0.0;
+            threshold = R_PosInf;
+
+            for (std::size_t i = 0; i < n; ) {
+                const double score { col_ptr[ranking.row(i, c)] };
+
+                do {
+                    const double w { ranking.weight<weighted>(ptr_weights, i, c) };
+                    const double positive { (ranking.label(ptr_actual, i, c) == class_label) ? w : 0.0 };
+
+                    true_positive  += positive;
+                    false_positive += w - positive;
+                    i++;
+                } while (i < n && col_ptr[ranking.row(i, c)] == score);
+
+                const double distance { true_positive / positives - false_positive / negatives };
+                if (distance > statistic) {
+                    statistic = distance;
+                    threshold = score;
+                }
+            }
+        }
+
+        /**
+        * @brief Compute the AUC of class c from the midranks (Mann-Whitney).
+        *
+        * Scanning the ranking in descending order, the tied scores form groups.
+        * Each positive in a group beats the negatives below the group, and ties
+        * with half of the negatives in the group, ie.
+        *
+        *   AUC = sum_g P_g * (N_below_g + 0.5 * N_g) / (P * N)
+        *
+        * which (unweighted) is the rank-sum statistic (R_1 - n_1 (n_1 + 1) / 2) / (n_1 n_0)
+        * with midranks for ties.
+        *
+        * @param ranking     The column-wise descending ordering of the response matrix.
+        * @param col_ptr     Pointer to column c of the response matrix.
+        * @param ptr_actual  Pointer to the actual class labels.
+        * @param ptr_weights Pointer to the weights (nullptr if unweighted).
+        * @param c           The column (class) of the ranking.
+        * @param n           The number of rows.
+        * @param class_label The class label (c + 1).
+        * @param positives   The total weight of the positives.
+        * @param negatives   The total weight of the negatives.
+        * @return            The AUC.
+        */
+        template <bool weighted>
+        static inline double rank_area(
+            const Ranking& ranking,
+            const double* col_ptr,
+            const int* ptr_actual,
+            const double* ptr_weights,
+            std::size_t c,
+            std::size_t n,
+            int class_label,
+            double positives,
+            double negatives)
+        {
+            double area { 0.0 };
+            double negatives_above { 0.0 };
+
+            for (std::size_t i = 0; i < n; ) {
+                const double score { col_ptr[ranking.row(i, c)] };
+                double group_positives { 0.0 };
+                double group_negatives { 0.0 };
+
+                std::size_t j = i;
+                do {
+                    const double w { ranking.weight<weighted>(ptr_weights, j, c) };
+                    if (ranking.label(ptr_actual, j, c) == class_label) {
+                        group_positives += w;
+                    } else {
+                        group_negatives += w;
+                    }
+                    j++;
+                } while (j < n && col_ptr[ranking.row(j, c)] == score);
+
+                area += group_positives * (negatives - negatives_above - 0.5 * group_negatives);
+                negatives_above += group_negatives;
+                i = j;
+            }
+
+            return area / (positives * negatives);
         }
 
         // prevent direct construction
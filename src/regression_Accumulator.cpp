@@ -0,0 +1,54 @@
+#include "regression_Accumulator.h"
+
+#include <Rcpp.h>
+
+using namespace Rcpp;
+
+//' @rdname accumulator
+//' @method accumulator numeric
+//' @export
+// [[Rcpp::export(accumulator.numeric)]]
+Rcpp::List accumulator_create(
+    const Rcpp::NumericVector& actual,
+    const Rcpp::NumericVector& predicted,
+    Rcpp::Nullable<Rcpp::NumericVector> w = R_NilValue,
+    double delta = 1.0) {
+
+        if (w.isNotNull()) {
+            const Rcpp::NumericVector weights(w);
+            return RegressionAccumulator::create(actual, predicted, &weights, delta);
+        }
+
+        return RegressionAccumulator::create(actual, predicted, nullptr, delta);
+}
+
+// [[Rcpp::export(.accumulator_update)]]
+Rcpp::List accumulator_update(
+    const Rcpp::List accumulator,
+    const Rcpp::NumericVector& actual,
+    const Rcpp::NumericVector& predicted,
+    Rcpp::Nullable<Rcpp::NumericVector> w = R_NilValue) {
+
+        if (w.isNotNull()) {
+            const Rcpp::NumericVector weights(w);
+            return RegressionAccumulator::update(accumulator, actual, predicted, &weights);
+        }
+
+        return RegressionAccumulator::update(accumulator, actual, predicted, nullptr);
+}
+
+// [[Rcpp::export(.accumulator_merge)]]
+Rcpp::List accumulator_merge(
+    const Rcpp::List x,
+    const Rcpp::List y) {
+        return RegressionAccumulator::merge(x, y);
+}
+
+// [[Rcpp::export(.accumulator_value)]]
+Rcpp::NumericVector accumulator_value(
+    const Rcpp::List accumulator,
+    const Rcpp::CharacterVector& measures,
+    double k = 0.0,
+    bool correction = false) {
+        return RegressionAccumulator::value(accumulator, measures, k, correction);
+}
@@ -0,0 +1,240 @@
+#ifndef REGRESSION_ACCUMULATOR_H
+#define REGRESSION_ACCUMULATOR_H
+
+#include <Rcpp.h>
+#include "utilities_Package.h"
+#include "regression_Metrics.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+/**
+ * @class RegressionAccumulator
+ * @brief A mergeable accumulator of the regression metrics.
+ *
+ * The accumulator holds the RegressionStatistics of all the observations
+ * added so far: the weighted sums of the losses and the Moments of the
+ * actual and predicted values. A batch is scanned with RegressionMetrics,
+ * in parallel, and merged into the statistics with the update of Chan et
+ * al., so an update is O(batch) and two accumulators of different shards
+ * are merged exactly, regardless of the order of the batches. The raw
+ * observations are never kept.
+ *
+ * The accumulator is a list of class <accumulator> with the elements:
+ *   - statistics: the named numeric vector of the RegressionStatistics.
+ *   - delta:      the threshold of the Huber loss.
+ *   - weighted:   true if the observations are weighted.
+ *
+ * It is a plain R object, so it is serialized with serialize() or saveRDS()
+ * and sent between processes as is. The metrics are computed from the
+ * statistics with RegressionMetrics::value(); all but rae(), which needs
+ * the observations for its deviations from the mean.
+ */
+class RegressionAccumulator {
+    public:
+        /**
+        * Create an accumulator from a batch.
+        *
+        * @param actual    Numeric vector of actual values.
+        * @param predicted Numeric vector of predicted values.
+        * @param weights   Optional vector of observation weights.
+        * @param delta     The threshold of the Huber loss.
+        */
+        static Rcpp::List create(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericVector& predicted,
+            const Rcpp::NumericVector* weights,
+            double delta)
+        {
+            return rebuild(scan(actual, predicted, weights, delta), delta, weights != nullptr);
+        }
+
+        /**
+        * Add a batch to a copy of the accumulator.
+        *
+        * @param accumulator An <accumulator>-object.
+        * @param actual      Numeric vector of actual values.
+        * @param predicted   Numeric vector of predicted values.
+        * @param weights     Optional vector of observation weights.
+        */
+        static Rcpp::List update(
+            const Rcpp::List& accumulator,
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericVector& predicted,
+            const Rcpp::NumericVector* weights)
+        {
+            const bool weighted { Rcpp::as<bool>(accumulator["weighted"]) };
+            const double delta { Rcpp::as<double>(accumulator["delta"]) };
+
+            if (weighted != (weights != nullptr)) {
+                Rcpp::stop("The accumulator is %s; `w` must be %s.", weighted ? "weighted" : "unweighted", weighted ? "passed" : "NULL");
+            }
+
+            RegressionStatistics statistics { unpack(accumulator) };
+            statistics.merge(scan(actual, predicted, weights, delta));
+
+            return rebuild(statistics, delta, weighted);
+        }
+
+        /**
+        * Merge two accumulators of the same weighting and delta.
+        */
+        static Rcpp::List merge(
+            const Rcpp::List& x,
+            const Rcpp::List& y)
+        {
+            const bool weighted { Rcpp::as<bool>(x["weighted"]) };
+            const double delta { Rcpp::as<double>(x["delta"]) };
+
+            if (weighted != Rcpp::as<bool>(y["weighted"])) {
+                Rcpp::stop("The accumulators must both be weighted, or both be unweighted.");
+            }
+            if (delta != Rcpp::as<double>(y["delta"])) {
+                Rcpp::stop("The accumulators must have the same `delta`.");
+            }
+
+            RegressionStatistics statistics { unpack(x) };
+            statistics.merge(unpack(y));
+
+            return rebuild(statistics, delta, weighted);
+        }
+
+        /**
+        * The metrics of the accumulated observations.
+        *
+        * @param accumulator An <accumulator>-object.
+        * @param metrics     Character vector of metric names.
+        * @param k           The number of predictors of the adjusted R^2.
+        * @param correction  If true, the CCC is computed with the (n - 1) / n correction.
+        * @return            A named numeric vector in the order of `metrics`.
+        */
+        static Rcpp::NumericVector value(
+            const Rcpp::List& accumulator,
+            const Rcpp::CharacterVector& metrics,
+            double k = 0.0,
+            bool correction = false)
+        {
+            const RegressionStatistics statistics { unpack(accumulator) };
+            const bool weighted { Rcpp::as<bool>(accumulator["weighted"]) };
+
+            Rcpp::NumericVector output(metrics.size());
+            for (R_xlen_t m = 0; m < metrics.size(); m++) {
+                const int metric { RegressionMetrics::metric(Rcpp::as<std::string>(metrics[m])) };
+                if (metric == RegressionMetrics::RELATIVE_ABSOLUTE) {
+                    Rcpp::stop("\"rae\" needs the observations, and is not available in accumulators.");
+                }
+
+                output[m] = RegressionMetrics::value(statistics, metric, weighted, k, correction);
+            }
+
+            output.attr("names") = metrics;
+
+            return output;
+        }
+
+    private:
+        // the statistics of all metrics
+        // but the spread of rae()
+        static constexpr unsigned plan {
+            RegressionMetrics::SQUARED | RegressionMetrics::ABSOLUTE | RegressionMetrics::RELATIVE |
+            RegressionMetrics::SYMMETRIC | RegressionMetrics::LOGARITHMIC | RegressionMetrics::HUBER_LOSS |
+            RegressionMetrics::ACTUAL | RegressionMetrics::PREDICTED | RegressionMetrics::BIAS
+        };
+
+        // the names of the
+        // packed statistics
+        static const std::vector<std::string>& names()
+        {
+            static const std::vector<std::string> names {
+                "n", "weight", "weight_sq", "squared", "absolute", "relative", "relative_ab",
+                "symmetric", "logarithmic", "huber", "mean_actual", "mean_predicted",
+                "m2_actual", "m2_predicted", "c_actual_predicted", "bias"
+            };
+
+            return names;
+        }
+
+        // scan a
+        // batch
+        static RegressionStatistics scan(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericVector& predicted,
+            const Rcpp::NumericVector* weights,
+            double delta)
+        {
+            if (predicted.size() != actual.size() || (weights && weights->size() != actual.size())) {
+                Rcpp::stop("`actual`, `predicted` and `w` must have the same length.");
+            }
+
+            return RegressionMetrics::scan(
+                actual.begin(),
+                predicted.begin(),
+                weights ? weights->begin() : nullptr,
+                actual.size(),
+                plan,
+                delta
+            );
+        }
+
+        // the statistics of
+        // the accumulator
+        static RegressionStatistics unpack(const Rcpp::List& accumulator)
+        {
+            const Rcpp::NumericVector values { Rcpp::as<Rcpp::NumericVector>(accumulator["statistics"]) };
+            if (static_cast<std::size_t>(values.size()) != names().size()) {
+                Rcpp::stop("The accumulator is malformed.");
+            }
+
+            RegressionStatistics s;
+            s.n           = values[0];
+            s.weight      = values[1];
+            s.weight_sq   = values[2];
+            s.squared     = values[3];
+            s.absolute    = values[4];
+            s.relative    = values[5];
+            s.relative_ab = values[6];
+            s.symmetric   = values[7];
+            s.logarithmic = values[8];
+            s.huber       = values[9];
+            s.bias        = values[15];
+
+            s.moments.weight    = s.weight;
+            s.moments.weight_sq = s.weight_sq;
+            s.moments.mean_x    = values[10];
+            s.moments.mean_y    = values[11];
+            s.moments.m2_x      = values[12];
+            s.moments.m2_y      = values[13];
+            s.moments.c_xy      = values[14];
+            s.moments.squared   = s.squared;
+
+            return s;
+        }
+
+        // the accumulator of
+        // the statistics
+        static Rcpp::List rebuild(const RegressionStatistics& s, double delta, bool weighted)
+        {
+            Rcpp::NumericVector values {
+                s.n, s.weight, s.weight_sq, s.squared, s.absolute, s.relative, s.relative_ab,
+                s.symmetric, s.logarithmic, s.huber, s.moments.mean_x, s.moments.mean_y,
+                s.moments.m2_x, s.moments.m2_y, s.moments.c_xy, s.bias
+            };
+            values.attr("names") = Rcpp::CharacterVector(names().begin(), names().end());
+
+            Rcpp::List output = Rcpp::List::create(
+                Rcpp::Named("statistics") = values,
+                Rcpp::Named("delta")      = delta,
+                Rcpp::Named("weighted")   = weighted
+            );
+            output.attr("class") = "accumulator";
+
+            return output;
+        }
+
+        // Prevents the compiler from doing
+        // bad stuff.
+        RegressionAccumulator()  = delete;
+        ~RegressionAccumulator() = delete;
+};
+
+#endif
@@ -2,6 +2,7 @@
 #define REGRESSION_COEFFICIENTOFDETERMINATION_H
 
 #include "utilities_Package.h"
+#include "utilities_Moments.h"
 #include <cmath>
 #include <cstddef>
 
@@ -26,29 +27,14 @@ class CoefficientOfDetermination {
                             std::size_t n,
                             double k)
         {
-            // 1) Compute mean of actual
-            double sumA = 0.0;
-            for (std::size_t i = 0; i < n; ++i) {
-                sumA += actual[i];
-            }
-            double meanA = sumA / static_cast<double>(n);
+            // 1) Compute SSE and SST
+            //    in one parallel pass
+            const Moments moments = Moments::compute(actual, predicted, nullptr, n);
 
-            // 2) Compute SSE and SST
-            double SSE = 0.0;
-            double SST = 0.0;
+            double SSE = moments.squared;
+            double SST = moments.m2_x;
 
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:SSE, SST) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double diffAm = (actual[i] - meanA);
-                double diffAp = (actual[i] - predicted[i]);
-
-                SST += diffAm * diffAm;
-                SSE += diffAp * diffAp;
-            }
-
-            // 3) Unadjusted R^2 = 1 - SSE/SST
+            // 2) Unadjusted R^2 = 1 - SSE/SST
             //    Adjusted => multiply (SSE/SST) by factor = ((n - 1) / (n - (k + 1))).
             //    So final = 1 - (SSE/SST) * factor
             double factor   = (static_cast<double>(n) - 1.0) / (static_cast<double>(n) - (k + 1.0));
@@ -65,7 +51,8 @@ class CoefficientOfDetermination {
         *   Weighted mean of actual = sum( w_i*a_i ) / sum( w_i )
         *   Weighted SST = sum( w_i * (a_i - wMean)^2 )
         *
-        * Then apply the same adjustment factor for k.
+        * Then apply the same adjustment factor for k. The sums are
+        * accumulated in one parallel pass with mergeable Moments.
         *
         * @param actual    Pointer to actual values
         * @param predicted Pointer to predicted values
@@ -81,42 +68,14 @@ class CoefficientOfDetermination {
                             std::size_t n,
                             double k)
         {
-            // 1) Compute weighted sums, SSE
-            double sumW   = 0.0;
-            double sumWA  = 0.0;
-            double SSE    = 0.0;
-
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:sumW, sumWA, SSE) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double w   = weights[i];
-                double a   = actual[i];
-                double p   = predicted[i];
-
-                sumW   += w;
-                sumWA  += (w * a);
-
-                double resid = a - p;
-                SSE    += w * resid * resid;
-            }
-
-            // Weighted mean of actual
-            double wMean = sumWA / sumW;
-
-            // 2) Weighted SST
-            double SST = 0.0;
+            // 1) Compute weighted SSE and SST
+            //    in one parallel pass
+            const Moments moments = Moments::compute(actual, predicted, weights, n);
 
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:SST) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double w   = weights[i];
-                double diff = actual[i] - wMean;
-                SST += w * diff * diff;
-            }
+            double SSE = moments.squared;
+            double SST = moments.m2_x;
 
-            // 3) Weighted R^2 or adjusted R^2
+            // 2) Weighted R^2 or adjusted R^2
             double factor   = (static_cast<double>(n) - 1.0) / (static_cast<double>(n) - (k + 1.0));
             double r2_value = 1.0 - ((SSE / SST) * factor);
 
@@ -0,0 +1,430 @@
+#ifndef REGRESSION_GROUPEDMETRICS_H
+#define REGRESSION_GROUPEDMETRICS_H
+
+#include <Rcpp.h>
+#include "utilities_Package.h"
+#include "regression_Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @class GroupedMetrics
+ * @brief Regression metrics of each group in one pass over the rows.
+ *
+ * The rows are labelled by an integer group code in 1, ..., G, ie. the
+ * codes of a factor. Each thread scans a contiguous range of the rows and
+ * accumulates the planned sums of RegressionMetrics into its own array of
+ * G groups, and the arrays are reduced over the threads in parallel over
+ * the groups. The means of each group are known after the first pass, so
+ * the centered sums of squares of R^2, RRSE and CCC, and the absolute
+ * deviations of RAE, are accumulated in a second pass around the means of
+ * the group; the statistics of each group are then those of scan().
+ *
+ * The number of threads is capped so that each thread-local array covers
+ * at least as many rows as it has groups.
+ */
+class GroupedMetrics {
+    public:
+        /**
+        * Compute the requested metrics of each group.
+        *
+        * @param actual     Numeric vector of actual values.
+        * @param predicted  Numeric vector of predicted values.
+        * @param group      Integer vector (or factor) of group codes in 1, ..., G.
+        * @param metrics    Character vector of metric names.
+        * @param weights    Optional vector of observation weights.
+        * @param delta      The threshold of the Huber loss.
+        * @param k          The number of predictors of the adjusted R^2.
+        * @param correction If true, the CCC is computed with the (n - 1) / n correction.
+        * @return           A G x m matrix; one row per group and one column per metric.
+        */
+        static Rcpp::NumericMatrix compute(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericVector& predicted,
+            const Rcpp::IntegerVector& group,
+            const Rcpp::CharacterVector& metrics,
+            const Rcpp::NumericVector* weights = nullptr,
+            double delta = 1.0,
+            double k = 0.0,
+            bool correction = false)
+        {
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+
+            // 1) validate the
+            //    groups
+            if (static_cast<std::size_t>(group.size()) != n) {
+                Rcpp::stop("`group` must have the same length as `actual`.");
+            }
+
+            Rcpp::RObject levels { group.attr("levels") };
+            int n_groups { Rf_isNull(levels) ? 0 : static_cast<int>(Rcpp::as<Rcpp::CharacterVector>(levels).size()) };
+
+            for (std::size_t i = 0; i < n; i++) {
+                if (group[i] == NA_INTEGER || group[i] < 1) {
+                    Rcpp::stop("`group` must be positive integer codes without missing values.");
+                }
+
+                if (Rf_isNull(levels)) n_groups = std::max(n_groups, group[i]);
+            }
+
+            if (!Rf_isNull(levels) && n > 0 && *std::max_element(group.begin(), group.end()) > n_groups) {
+                Rcpp::stop("`group` has codes above the number of levels.");
+            }
+
+            // 2) map the names
+            //    to the metrics
+            std::vector<int> requested(metrics.size());
+            for (R_xlen_t m = 0; m < metrics.size(); m++) {
+                requested[m] = RegressionMetrics::metric(Rcpp::as<std::string>(metrics[m]));
+            }
+
+            // 3) the statistics
+            //    of each group
+            const std::vector<RegressionStatistics> statistics {
+                scan(
+                    actual.begin(),
+                    predicted.begin(),
+                    weights ? weights->begin() : nullptr,
+                    group.begin(),
+                    n,
+                    static_cast<std::size_t>(n_groups),
+                    RegressionMetrics::plan(requested),
+                    delta
+                )
+            };
+
+            // 4) the metrics of
+            //    each group
+            Rcpp::NumericMatrix output(n_groups, static_cast<int>(requested.size()));
+            for (int g = 0; g < n_groups; g++) {
+                for (std::size_t m = 0; m < requested.size(); m++) {
+                    output(g, m) = RegressionMetrics::value(statistics[g], requested[m], weights != nullptr, k, correction);
+                }
+            }
+
+            // 5) the rows are named by the
+            //    levels, or the group codes
+            Rcpp::CharacterVector rows(n_groups);
+            if (Rf_isNull(levels)) {
+                for (int g = 0; g < n_groups; g++) rows[g] = std::to_string(g + 1);
+            } else {
+                rows = Rcpp::as<Rcpp::CharacterVector>(levels);
+            }
+            output.attr("dimnames") = Rcpp::List::create(rows, metrics);
+
+            return output;
+        }
+
+        /**
+        * Accumulate the planned statistics of each group.
+        *
+        * @param actual    Pointer to actual values.
+        * @param predicted Pointer to predicted values.
+        * @param weights   Pointer to weights; nullptr for unweighted statistics.
+        * @param group     Pointer to the group codes in 1, ..., G.
+        * @param n         Number of observations.
+        * @param n_groups  Number of groups, G.
+        * @param plan      The RegressionMetrics::statistic_types to accumulate.
+        * @param delta     The threshold of the Huber loss.
+        * @return          The RegressionStatistics of each group.
+        */
+        static std::vector<RegressionStatistics> scan(
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            const int* group,
+            std::size_t n,
+            std::size_t n_groups,
+            unsigned plan,
+            double delta = 1.0)
+        {
+            // 1) the first pass; the sums
+            //    and the means of each group
+            std::vector<Sums> sums(n_groups);
+            if (weights) {
+                reduce<Sums>(sums, n, [&](Sums* local, std::size_t first, std::size_t last) {
+                    first_pass<true>(local, actual, predicted, weights, group, first, last, plan, delta);
+                });
+            } else {
+                reduce<Sums>(sums, n, [&](Sums* local, std::size_t first, std::size_t last) {
+                    first_pass<false>(local, actual, predicted, weights, group, first, last, plan, delta);
+                });
+            }
+
+            // 2) the second pass; the deviations
+            //    from the means of each group
+            std::vector<Deviations> deviations(n_groups);
+            if (plan & (RegressionMetrics::ACTUAL | RegressionMetrics::PREDICTED | RegressionMetrics::SPREAD)) {
+                std::vector<double> mean_a(n_groups), mean_p(n_groups);
+                for (std::size_t g = 0; g < n_groups; g++) {
+                    mean_a[g] = sums[g].actual / sums[g].weight;
+                    mean_p[g] = sums[g].predicted / sums[g].weight;
+                }
+
+                if (weights) {
+                    reduce<Deviations>(deviations, n, [&](Deviations* local, std::size_t first, std::size_t last) {
+                        second_pass<true>(local, actual, predicted, weights, group, first, last, plan, mean_a.data(), mean_p.data());
+                    });
+                } else {
+                    reduce<Deviations>(deviations, n, [&](Deviations* local, std::size_t first, std::size_t last) {
+                        second_pass<false>(local, actual, predicted, weights, group, first, last, plan, mean_a.data(), mean_p.data());
+                    });
+                }
+            }
+
+            // 3) the statistics
+            //    of each group
+            std::vector<RegressionStatistics> statistics(n_groups);
+            for (std::size_t g = 0; g < n_groups; g++) {
+                const Sums& s { sums[g] };
+                const Deviations& d { deviations[g] };
+                RegressionStatistics& output { statistics[g] };
+
+                output.n           = s.n;
+                output.weight      = s.weight;
+                output.weight_sq   = s.weight_sq;
+                output.bias        = s.bias;
+                output.squared     = s.squared;
+                output.absolute    = s.absolute;
+                output.relative    = s.relative;
+                output.relative_ab = s.relative_ab;
+                output.symmetric   = s.symmetric;
+                output.logarithmic = s.logarithmic;
+                output.huber       = s.huber;
+                output.spread      = d.spread;
+
+                output.moments.weight    = s.weight;
+                output.moments.weight_sq = s.weight_sq;
+                output.moments.mean_x    = s.actual / s.weight;
+                output.moments.mean_y    = s.predicted / s.weight;
+                output.moments.m2_x      = d.m2_a;
+                output.moments.m2_y      = d.m2_p;
+                output.moments.c_xy      = d.c_ap;
+                output.moments.squared   = s.squared;
+            }
+
+            return statistics;
+        }
+
+    private:
+        // the first pass
+        // sums of a group
+        struct Sums {
+            double n           = 0.0;
+            double weight      = 0.0;
+            double weight_sq   = 0.0;
+            double bias        = 0.0;
+            double squared     = 0.0;
+            double absolute    = 0.0;
+            double relative    = 0.0;
+            double relative_ab = 0.0;
+            double symmetric   = 0.0;
+            double logarithmic = 0.0;
+            double huber       = 0.0;
+            double actual      = 0.0;  // sum(w * a)
+            double predicted   = 0.0;  // sum(w * p)
+
+            void merge(const Sums& other) {
+                n           += other.n;
+                weight      += other.weight;
+                weight_sq   += other.weight_sq;
+                bias        += other.bias;
+                squared     += other.squared;
+                absolute    += other.absolute;
+                relative    += other.relative;
+                relative_ab += other.relative_ab;
+                symmetric   += other.symmetric;
+                logarithmic += other.logarithmic;
+                huber       += other.huber;
+                actual      += other.actual;
+                predicted   += other.predicted;
+            }
+        };
+
+        // the second pass
+        // sums of a group
+        struct Deviations {
+            double m2_a   = 0.0;  // sum(w * (a - mean(a))^2)
+            double m2_p   = 0.0;  // sum(w * (p - mean(p))^2)
+            double c_ap   = 0.0;  // sum(w * (a - mean(a)) * (p - mean(p)))
+            double spread = 0.0;  // sum(w * |a - mean(a)|)
+
+            void merge(const Deviations& other) {
+                m2_a   += other.m2_a;
+                m2_p   += other.m2_p;
+                c_ap   += other.c_ap;
+                spread += other.spread;
+            }
+        };
+
+        /**
+        * @brief Run pass(local, first, last) on a contiguous range of rows per thread,
+        *        and reduce the thread-local arrays into `output` in parallel over the groups.
+        */
+        template <typename Statistic, typename Pass>
+        static void reduce(std::vector<Statistic>& output, std::size_t n, Pass pass)
+        {
+            const std::size_t n_groups { output.size() };
+
+            int n_threads { 1 };
+            #ifdef _OPENMP
+                if (getUseOpenMP()) {
+                    // each thread-local array
+                    // must cover enough rows
+                    const std::size_t cap { n_groups > 0 ? n / n_groups : n };
+                    n_threads = static_cast<int>(std::max<std::size_t>(1, std::min<std::size_t>(omp_get_max_threads(), cap)));
+                }
+            #endif
+
+            if (n_threads == 1) {
+                pass(output.data(), 0, n);
+                return;
+            }
+
+            std::vector<std::vector<Statistic>> locals(n_threads);
+
+            #ifdef _OPENMP
+                #pragma omp parallel num_threads(n_threads)
+            #endif
+            {
+                int thread { 0 }, threads { 1 };
+                #ifdef _OPENMP
+                    thread  = omp_get_thread_num();
+                    threads = omp_get_num_threads();
+                #endif
+
+                // 1) each thread accumulates
+                //    a contiguous range of rows
+                locals[thread].resize(n_groups);
+
+                const std::size_t first { n * thread / threads };
+                const std::size_t last  { n * (thread + 1) / threads };
+                pass(locals[thread].data(), first, last);
+
+                #ifdef _OPENMP
+                    #pragma omp barrier
+                #endif
+
+                // 2) reduce the thread-local
+                //    arrays over the groups
+                #ifdef _OPENMP
+                    #pragma omp for schedule(static)
+                #endif
+                for (std::size_t g = 0; g < n_groups; g++) {
+                    for (int t = 0; t < threads; t++) {
+                        output[g].merge(locals[t][g]);
+                    }
+                }
+            }
+        }
+
+        /**
+        * @brief The first pass over the rows [first, last); the planned sums of each group.
+        */
+        template <bool weighted>
+        static void first_pass(
+            Sums* sums,
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            const int* group,
+            std::size_t first,
+            std::size_t last,
+            unsigned plan,
+            double delta)
+        {
+            const bool moments { (plan & (RegressionMetrics::ACTUAL | RegressionMetrics::PREDICTED | RegressionMetrics::SPREAD)) != 0u };
+
+            for (std::size_t i = first; i < last; i++) {
+                Sums& s { sums[group[i] - 1] };
+
+                const double w { weighted ? weights[i] : 1.0 };
+                const double a { actual[i] };
+                const double p { predicted[i] };
+                const double d { a - p };
+
+                s.n         += 1.0;
+                s.weight    += w;
+                s.weight_sq += w * w;
+
+                if (plan & RegressionMetrics::BIAS)     s.bias     += w * d;
+                if (plan & RegressionMetrics::SQUARED)  s.squared  += w * d * d;
+                if (plan & RegressionMetrics::ABSOLUTE) s.absolute += w * std::fabs(d);
+
+                if (plan & RegressionMetrics::RELATIVE) {
+                    s.relative    += w * (d / a);
+                    s.relative_ab += w * (std::fabs(d) / a);
+                }
+
+                if (plan & RegressionMetrics::SYMMETRIC) {
+                    s.symmetric += w * (std::fabs(d) / ((std::fabs(a) + std::fabs(p)) / 2.0));
+                }
+
+                if (plan & RegressionMetrics::LOGARITHMIC) {
+                    const double l { std::log(a + 1.0) - std::log(p + 1.0) };
+                    s.logarithmic += w * l * l;
+                }
+
+                if (plan & RegressionMetrics::HUBER_LOSS) {
+                    const double abs_d { std::fabs(d) };
+                    s.huber += w * (abs_d <= delta ? 0.5 * d * d : delta * (abs_d - 0.5 * delta));
+                }
+
+                if (moments) {
+                    s.actual    += w * a;
+                    s.predicted += w * p;
+                }
+            }
+        }
+
+        /**
+        * @brief The second pass over the rows [first, last); the deviations from the means of each group.
+        */
+        template <bool weighted>
+        static void second_pass(
+            Deviations* deviations,
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            const int* group,
+            std::size_t first,
+            std::size_t last,
+            unsigned plan,
+            const double* mean_a,
+            const double* mean_p)
+        {
+            const bool bivariate { (plan & RegressionMetrics::PREDICTED) != 0u };
+            const bool spread    { (plan & RegressionMetrics::SPREAD) != 0u };
+
+            for (std::size_t i = first; i < last; i++) {
+                const int g { group[i] - 1 };
+                Deviations& s { deviations[g] };
+
+                const double w  { weighted ? weights[i] : 1.0 };
+                const double da { actual[i] - mean_a[g] };
+
+                s.m2_a += w * da * da;
+                if (spread) s.spread += w * std::fabs(da);
+
+                if (bivariate) {
+                    const double dp { predicted[i] - mean_p[g] };
+                    s.m2_p += w * dp * dp;
+                    s.c_ap += w * da * dp;
+                }
+            }
+        }
+
+        // Prevents the compiler from doing
+        // bad stuff.
+        GroupedMetrics()  = delete;
+        ~GroupedMetrics() = delete;
+};
+
+#endif
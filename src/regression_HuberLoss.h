@@ -2,6 +2,7 @@
 #define REGRESSION_HUBERLOSS_H
 
 #include "utilities_Package.h"
+#include "utilities_SIMD.h"
 #include <cmath>
 #include <cstddef>
 
@@ -24,25 +25,10 @@ class HuberLoss {
 
         static double compute(const double* actual, const double* predicted, std::size_t n, double delta)
         {
-            double loss_sum = 0.0;
+            double weight = 0.0;
+            double loss_sum = SIMD::reduce(SIMD::kernels().huber, actual, predicted, nullptr, n, delta, weight);
 
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:loss_sum) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double diff = actual[i] - predicted[i];
-                double abs_diff = std::fabs(diff);
-
-                if (abs_diff <= delta) {
-                    // Quadratic region
-                    loss_sum += 0.5 * diff * diff;
-                } else {
-                    // Linear region
-                    loss_sum += delta * (abs_diff - 0.5 * delta);
-                }
-            }
-
-            return loss_sum / static_cast<double>(n);
+            return loss_sum / weight;
         }
 
         /**
@@ -58,27 +44,8 @@ class HuberLoss {
         */
         static double compute(const double* actual, const double* predicted, const double* weights, std::size_t n, double delta)
         {
-            double loss_sum = 0.0;
             double weight_sum = 0.0;
-
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:loss_sum, weight_sum) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double w = weights[i];
-                double diff = actual[i] - predicted[i];
-                double abs_diff = std::fabs(diff);
-
-                if (abs_diff <= delta) {
-                    // Quadratic region
-                    loss_sum += w * (0.5 * diff * diff);
-                } else {
-                    // Linear region
-                    loss_sum += w * (delta * (abs_diff - 0.5 * delta));
-                }
-
-                weight_sum += w;
-            }
+            double loss_sum   = SIMD::reduce(SIMD::kernels().huber, actual, predicted, weights, n, delta, weight_sum);
 
             return loss_sum / weight_sum;
         }
@@ -2,6 +2,7 @@
 #define REGRESSION_MEANSQUAREDERROR_H
 
 #include "utilities_Package.h"
+#include "utilities_SIMD.h"
 #include <cmath>
 #include <cstddef>
 
@@ -14,34 +15,17 @@ class MSE {
         // Unweighted MSE
         static double compute(const double* actual, const double* predicted, std::size_t n)
         {
-            double sum_sq_diff = 0.0;
+            double weight = 0.0;
+            double sum_sq_diff = SIMD::reduce(SIMD::kernels().squared, actual, predicted, nullptr, n, 0.0, weight);
 
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:sum_sq_diff) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double diff = actual[i] - predicted[i];
-                sum_sq_diff += diff * diff;
-            }
-
-            return sum_sq_diff / static_cast<double>(n);
+            return sum_sq_diff / weight;
         }
 
         // Weighted MSE
         static double compute(const double* actual, const double* predicted, const double* weights, std::size_t n)
         {
-            double sum_sq_diff = 0.0;
             double sum_w       = 0.0;
-
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:sum_sq_diff, sum_w) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double diff = actual[i] - predicted[i];
-                double w    = weights[i];
-                sum_sq_diff += w * diff * diff;
-                sum_w       += w;
-            }
+            double sum_sq_diff = SIMD::reduce(SIMD::kernels().squared, actual, predicted, weights, n, 0.0, sum_w);
 
             return sum_sq_diff / sum_w;
         }
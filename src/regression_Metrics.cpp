@@ -0,0 +1,45 @@
+#include <Rcpp.h>
+#include "regression_Metrics.h"
+#include "regression_GroupedMetrics.h"
+using namespace Rcpp;
+
+//' @rdname metrics
+//' @method metrics numeric
+//' @export
+// [[Rcpp::export(metrics.numeric)]]
+Rcpp::NumericVector metrics(
+    const Rcpp::NumericVector& actual,
+    const Rcpp::NumericVector& predicted,
+    const Rcpp::CharacterVector& measures = Rcpp::CharacterVector::create("mse", "rmse", "mae", "mape", "smape", "mpe", "rmsle", "rsq", "rae", "rrse", "huberloss", "ccc"),
+    double delta = 1.0,
+    double k = 0.0,
+    bool correction = false,
+    Rcpp::Nullable<Rcpp::IntegerVector> group = R_NilValue)
+{
+    if (group.isNotNull()) {
+        return GroupedMetrics::compute(actual, predicted, Rcpp::IntegerVector(group), measures, nullptr, delta, k, correction);
+    }
+
+    return RegressionMetrics::compute(actual, predicted, measures, nullptr, delta, k, correction);
+}
+
+//' @rdname metrics
+//' @method weighted.metrics numeric
+//' @export
+// [[Rcpp::export(weighted.metrics.numeric)]]
+Rcpp::NumericVector weighted_metrics(
+    const Rcpp::NumericVector& actual,
+    const Rcpp::NumericVector& predicted,
+    const Rcpp::NumericVector& w,
+    const Rcpp::CharacterVector& measures = Rcpp::CharacterVector::create("mse", "rmse", "mae", "mape", "smape", "mpe", "rmsle", "rsq", "rae", "rrse", "huberloss", "ccc"),
+    double delta = 1.0,
+    double k = 0.0,
+    bool correction = false,
+    Rcpp::Nullable<Rcpp::IntegerVector> group = R_NilValue)
+{
+    if (group.isNotNull()) {
+        return GroupedMetrics::compute(actual, predicted, Rcpp::IntegerVector(group), measures, &w, delta, k, correction);
+    }
+
+    return RegressionMetrics::compute(actual, predicted, measures, &w, delta, k, correction);
+}
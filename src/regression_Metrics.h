@@ -0,0 +1,521 @@
+#ifndef REGRESSION_METRICS_H
+#define REGRESSION_METRICS_H
+
+#include "utilities_Package.h"
+#include "utilities_SIMD.h"
+#include "utilities_Moments.h"
+#include <Rcpp.h>
+#include <vector>
+#include <string>
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @struct RegressionStatistics
+ * @brief The sufficient statistics of the regression metrics.
+ *
+ * All sums are weighted; the unweighted statistics use a unit weight.
+ * The moments of the actual and predicted values are mergeable Moments,
+ * so the one-pass sums of squares do not cancel when the values are far
+ * from zero.
+ */
+struct RegressionStatistics {
+    double n           = 0.0;  // number of observations
+    double weight      = 0.0;  // sum(w)
+    double weight_sq   = 0.0;  // sum(w^2)
+    double bias        = 0.0;  // sum(w * d)
+    double squared     = 0.0;  // sum(w * d^2)
+    double absolute    = 0.0;  // sum(w * |d|)
+    double relative    = 0.0;  // sum(w * d / a)
+    double relative_ab = 0.0;  // sum(w * |d| / a)
+    double symmetric   = 0.0;  // sum(w * |d| / ((|a| + |p|) / 2))
+    double logarithmic = 0.0;  // sum(w * (log(a + 1) - log(p + 1))^2)
+    double huber       = 0.0;  // sum(w * huber(d))
+    double spread      = 0.0;  // sum(w * |a - mean(a)|); second pass
+    Moments moments;           // the moments of a and p
+
+    // merge the statistics
+    // of another block
+    void merge(const RegressionStatistics& other) {
+        n           += other.n;
+        weight      += other.weight;
+        weight_sq   += other.weight_sq;
+        bias        += other.bias;
+        squared     += other.squared;
+        absolute    += other.absolute;
+        relative    += other.relative;
+        relative_ab += other.relative_ab;
+        symmetric   += other.symmetric;
+        logarithmic += other.logarithmic;
+        huber       += other.huber;
+        spread      += other.spread;
+        moments.merge(other.moments);
+    }
+};
+
+/**
+ * @class RegressionMetrics
+ * @brief Fused evaluation of several regression metrics.
+ *
+ * The requested metrics are planned into the minimal set of sufficient
+ * statistics, which are accumulated in one parallel scan over the rows.
+ * The rows are processed in cache-sized blocks, and each statistic has its
+ * own vectorized loop over the block, so the input is read from memory
+ * once regardless of the number of metrics. The losses of the residuals
+ * use the kernels of utilities_SIMD.h. Only rae() needs a second pass,
+ * for the absolute deviations from the mean of the actual values.
+ */
+class RegressionMetrics {
+    public:
+        // the metrics
+        enum metric_type {
+            MEAN_SQUARED = 0, ROOT_MEAN_SQUARED, MEAN_ABSOLUTE, MEAN_ABSOLUTE_PERCENTAGE,
+            SYMMETRIC_MEAN_ABSOLUTE_PERCENTAGE, MEAN_PERCENTAGE, ROOT_MEAN_SQUARED_LOGARITHMIC,
+            DETERMINATION, RELATIVE_ABSOLUTE, ROOT_RELATIVE_SQUARED, HUBER, CONCORDANCE,
+            MEAN_ERROR
+        };
+
+        // the sufficient statistics
+        enum statistic_type : unsigned {
+            SQUARED     = 1u << 0,
+            ABSOLUTE    = 1u << 1,
+            RELATIVE    = 1u << 2,
+            SYMMETRIC   = 1u << 3,
+            LOGARITHMIC = 1u << 4,
+            HUBER_LOSS  = 1u << 5,
+            ACTUAL      = 1u << 6,
+            PREDICTED   = 1u << 7,
+            SPREAD      = 1u << 8,
+            BIAS        = 1u << 9
+        };
+
+        /**
+        * Map the name of a metric, as in the R function, to its metric_type.
+        *
+        * @param name The name of the metric, ie. "mse" or "huberloss".
+        * @return     The metric_type; stops on unknown names.
+        */
+        static int metric(const std::string& name)
+        {
+            for (std::size_t m = 0; m < names().size(); m++) {
+                if (names()[m] == name) return static_cast<int>(m);
+            }
+
+            Rcpp::stop("Unknown metric \"%s\"; must be one of %s.", name, collapse());
+        }
+
+        /**
+        * Plan the sufficient statistics of the requested metrics.
+        *
+        * @param metrics The metric_types.
+        * @return        The union of the statistic_types needed.
+        */
+        static unsigned plan(const std::vector<int>& metrics)
+        {
+            unsigned plan { 0u };
+
+            for (int m : metrics) {
+                switch (m) {
+                    case MEAN_SQUARED:
+                    case ROOT_MEAN_SQUARED:                  plan |= SQUARED;                       break;
+                    case MEAN_ABSOLUTE:                      plan |= ABSOLUTE;                      break;
+                    case MEAN_ABSOLUTE_PERCENTAGE:
+                    case MEAN_PERCENTAGE:                    plan |= RELATIVE;                      break;
+                    case SYMMETRIC_MEAN_ABSOLUTE_PERCENTAGE: plan |= SYMMETRIC;                     break;
+                    case ROOT_MEAN_SQUARED_LOGARITHMIC:      plan |= LOGARITHMIC;                   break;
+                    case DETERMINATION:
+                    case ROOT_RELATIVE_SQUARED:              plan |= SQUARED | ACTUAL;              break;
+                    case RELATIVE_ABSOLUTE:                  plan |= ABSOLUTE | ACTUAL | SPREAD;    break;
+                    case HUBER:                              plan |= HUBER_LOSS;                    break;
+                    case CONCORDANCE:                        plan |= ACTUAL | PREDICTED;            break;
+                    case MEAN_ERROR:                         plan |= BIAS;                          break;
+                }
+            }
+
+            return plan;
+        }
+
+        /**
+        * Accumulate the planned statistics.
+        *
+        * @param actual    Pointer to actual values.
+        * @param predicted Pointer to predicted values.
+        * @param weights   Pointer to weights; nullptr for unweighted statistics.
+        * @param n         Number of observations.
+        * @param plan      The statistic_types to accumulate.
+        * @param delta     The threshold of the Huber loss.
+        * @return          The RegressionStatistics.
+        */
+        static RegressionStatistics scan(
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            unsigned plan,
+            double delta = 1.0)
+        {
+            RegressionStatistics statistics;
+            statistics.n = static_cast<double>(n);
+
+            // 1) the first pass
+            if (weights) {
+                first_pass<true>(statistics, actual, predicted, weights, n, plan, delta);
+            } else {
+                first_pass<false>(statistics, actual, predicted, weights, n, plan, delta);
+                statistics.weight    = statistics.n;
+                statistics.weight_sq = statistics.n;
+            }
+
+            // 2) the second pass; the absolute
+            //    deviations from the mean
+            if (plan & SPREAD) {
+                const double mean { statistics.moments.mean_x };
+
+                if (weights) {
+                    second_pass<true>(statistics, actual, weights, n, mean);
+                } else {
+                    second_pass<false>(statistics, actual, weights, n, mean);
+                }
+            }
+
+            return statistics;
+        }
+
+        /**
+        * Compute a metric from the sufficient statistics.
+        *
+        * @param statistics The RegressionStatistics from scan().
+        * @param metric     The metric_type.
+        * @param weighted   True if the statistics are weighted.
+        * @param k          The number of predictors of the adjusted R^2.
+        * @param correction If true, the CCC is computed with the (n - 1) / n correction.
+        * @return           The value of the metric.
+        */
+        static double value(
+            const RegressionStatistics& statistics,
+            int metric,
+            bool weighted,
+            double k = 0.0,
+            bool correction = false)
+        {
+            const RegressionStatistics& s { statistics };
+            const double W { s.weight };
+
+            switch (metric) {
+                case MEAN_SQUARED:                       return s.squared / W;
+                case ROOT_MEAN_SQUARED:                  return std::sqrt(s.squared / W);
+                case MEAN_ABSOLUTE:                      return s.absolute / W;
+                case MEAN_ABSOLUTE_PERCENTAGE:           return s.relative_ab / W;
+                case SYMMETRIC_MEAN_ABSOLUTE_PERCENTAGE: return s.symmetric / W;
+                case MEAN_PERCENTAGE:                    return s.relative / W;
+                case ROOT_MEAN_SQUARED_LOGARITHMIC:      return std::sqrt(s.logarithmic / W);
+                case HUBER:                              return s.huber / W;
+                case MEAN_ERROR:                         return s.bias / W;
+                case RELATIVE_ABSOLUTE:                  return s.absolute / s.spread;
+                case ROOT_RELATIVE_SQUARED:              return std::sqrt(s.squared / total_squares(s));
+                case DETERMINATION: {
+                    const double factor { (s.n - 1.0) / (s.n - (k + 1.0)) };
+                    return 1.0 - (s.squared / total_squares(s)) * factor;
+                }
+                case CONCORDANCE: {
+                    // the (co)variances as in CovarianceCalculator::cov()
+                    double denominator { s.n - 1.0 };
+                    double scale       { 1.0 };
+
+                    if (weighted) {
+                        const double sum_norm_sq { s.weight_sq / (W * W) };
+                        denominator = (1.0 - sum_norm_sq) > 0.0 ? W * (1.0 - sum_norm_sq) : W;
+                        if (correction) scale = (W - 1.0) / W;
+                    } else if (correction) {
+                        scale = (s.n - 1.0) / s.n;
+                    }
+
+                    const double sxx { scale * s.moments.m2_x / denominator };
+                    const double syy { scale * s.moments.m2_y / denominator };
+                    const double sxy { scale * s.moments.c_xy / denominator };
+                    const double mean_difference { s.moments.mean_x - s.moments.mean_y };
+
+                    return 2.0 * sxy / (sxx + syy + mean_difference * mean_difference);
+                }
+            }
+
+            return NA_REAL;
+        }
+
+        /**
+        * Compute the requested metrics in one scan.
+        *
+        * @param actual     Numeric vector of actual values.
+        * @param predicted  Numeric vector of predicted values.
+        * @param metrics    Character vector of metric names.
+        * @param weights    Optional vector of observation weights.
+        * @param delta      The threshold of the Huber loss.
+        * @param k          The number of predictors of the adjusted R^2.
+        * @param correction If true, the CCC is computed with the (n - 1) / n correction.
+        * @return           A named numeric vector in the order of `metrics`.
+        */
+        static Rcpp::NumericVector compute(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericVector& predicted,
+            const Rcpp::CharacterVector& metrics,
+            const Rcpp::NumericVector* weights = nullptr,
+            double delta = 1.0,
+            double k = 0.0,
+            bool correction = false)
+        {
+            // 1) map the names
+            //    to the metrics
+            std::vector<int> requested(metrics.size());
+            for (R_xlen_t m = 0; m < metrics.size(); m++) {
+                requested[m] = metric(Rcpp::as<std::string>(metrics[m]));
+            }
+
+            // 2) accumulate the
+            //    sufficient statistics
+            const RegressionStatistics statistics {
+                scan(
+                    actual.begin(),
+                    predicted.begin(),
+                    weights ? weights->begin() : nullptr,
+                    actual.size(),
+                    plan(requested),
+                    delta
+                )
+            };
+
+            // 3) compute the
+            //    metrics
+            Rcpp::NumericVector output(requested.size());
+            for (std::size_t m = 0; m < requested.size(); m++) {
+                output[m] = value(statistics, requested[m], weights != nullptr, k, correction);
+            }
+
+            output.attr("names") = metrics;
+
+            return output;
+        }
+
+        // the names of the metrics
+        // in the order of metric_type
+        static const std::vector<std::string>& names()
+        {
+            static const std::vector<std::string> names {
+                "mse", "rmse", "mae", "mape", "smape", "mpe",
+                "rmsle", "rsq", "rae", "rrse", "huberloss", "ccc",
+                "bias"
+            };
+
+            return names;
+        }
+
+    private:
+        // rows per block; the block of
+        // all three inputs stays in cache
+        static constexpr std::size_t block_size = 2048;
+
+        // the total sum of squares
+        static double total_squares(const RegressionStatistics& s)
+        {
+            return s.moments.m2_x;
+        }
+
+        static std::string collapse()
+        {
+            std::string output;
+            for (std::size_t m = 0; m < names().size(); m++) {
+                output += (m > 0 ? ", \"" : "\"") + names()[m] + "\"";
+            }
+
+            return output;
+        }
+
+        /**
+        * @brief The first pass over the blocks; one thread-local set of statistics per thread.
+        */
+        template <bool weighted>
+        static void first_pass(
+            RegressionStatistics& statistics,
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            unsigned plan,
+            double delta)
+        {
+            const std::size_t n_blocks { (n + block_size - 1) / block_size };
+
+            #ifdef _OPENMP
+                #pragma omp parallel if(getUseOpenMP())
+            #endif
+            {
+                RegressionStatistics local;
+
+                #ifdef _OPENMP
+                    #pragma omp for schedule(static)
+                #endif
+                for (std::size_t b = 0; b < n_blocks; b++) {
+                    const std::size_t first { b * block_size };
+                    const std::size_t last  { std::min(n, first + block_size) };
+
+                    accumulate<weighted>(local, actual + first, predicted + first, weighted ? weights + first : nullptr, last - first, plan, delta);
+                }
+
+                #ifdef _OPENMP
+                    #pragma omp critical
+                #endif
+                {
+                    statistics.merge(local);
+                }
+            }
+        }
+
+        /**
+        * @brief Accumulate the planned statistics of one block; each statistic is a separate loop.
+        */
+        template <bool weighted>
+        static void accumulate(
+            RegressionStatistics& s,
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            unsigned plan,
+            double delta)
+        {
+            // the weight of
+            // row i
+            auto weight = [weights](std::size_t i) -> double {
+                if constexpr (weighted) return weights[i]; else return 1.0;
+            };
+
+            if constexpr (weighted) {
+                double sum_w = 0.0, sum_w_sq = 0.0;
+
+                #ifdef _OPENMP
+                    #pragma omp simd reduction(+:sum_w, sum_w_sq)
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    sum_w    += weights[i];
+                    sum_w_sq += weights[i] * weights[i];
+                }
+
+                s.weight    += sum_w;
+                s.weight_sq += sum_w_sq;
+            }
+
+            // the losses of the residuals
+            // use the vectorized kernels
+            const SIMD::kernel_table& kernels { SIMD::kernels() };
+            double unused = 0.0;
+
+            if (plan & BIAS) {
+                double sum = 0.0;
+
+                #ifdef _OPENMP
+                    #pragma omp simd reduction(+:sum)
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    sum += weight(i) * (actual[i] - predicted[i]);
+                }
+
+                s.bias += sum;
+            }
+
+            if (plan & SQUARED) {
+                s.squared += kernels.squared(actual, predicted, weights, n, 0.0, unused);
+            }
+
+            if (plan & ABSOLUTE) {
+                s.absolute += kernels.absolute(actual, predicted, weights, n, 0.0, unused);
+            }
+
+            if (plan & RELATIVE) {
+                double sum = 0.0, sum_abs = 0.0;
+
+                #ifdef _OPENMP
+                    #pragma omp simd reduction(+:sum, sum_abs)
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    const double ratio { (actual[i] - predicted[i]) / actual[i] };
+                    sum     += weight(i) * ratio;
+                    sum_abs += weight(i) * (std::fabs(actual[i] - predicted[i]) / actual[i]);
+                }
+
+                s.relative    += sum;
+                s.relative_ab += sum_abs;
+            }
+
+            if (plan & SYMMETRIC) {
+                double sum = 0.0;
+
+                #ifdef _OPENMP
+                    #pragma omp simd reduction(+:sum)
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    const double denominator { (std::fabs(actual[i]) + std::fabs(predicted[i])) / 2.0 };
+                    sum += weight(i) * (std::fabs(actual[i] - predicted[i]) / denominator);
+                }
+
+                s.symmetric += sum;
+            }
+
+            if (plan & LOGARITHMIC) {
+                double sum = 0.0;
+
+                for (std::size_t i = 0; i < n; i++) {
+                    const double d { std::log(actual[i] + 1.0) - std::log(predicted[i] + 1.0) };
+                    sum += weight(i) * d * d;
+                }
+
+                s.logarithmic += sum;
+            }
+
+            if (plan & HUBER_LOSS) {
+                s.huber += kernels.huber(actual, predicted, weights, n, delta, unused);
+            }
+
+            if (plan & (ACTUAL | PREDICTED)) {
+                s.moments.merge(Moments::block(actual, (plan & PREDICTED) ? predicted : nullptr, weights, n));
+            }
+        }
+
+        /**
+        * @brief The second pass; the absolute deviations from the (weighted) mean.
+        */
+        template <bool weighted>
+        static void second_pass(
+            RegressionStatistics& statistics,
+            const double* actual,
+            const double* weights,
+            std::size_t n,
+            double mean)
+        {
+            double spread = 0.0;
+
+            #ifdef _OPENMP
+                #pragma omp parallel for simd reduction(+:spread) if(getUseOpenMP())
+            #endif
+            for (std::size_t i = 0; i < n; i++) {
+                if constexpr (weighted) {
+                    spread += weights[i] * std::fabs(actual[i] - mean);
+                } else {
+                    spread += std::fabs(actual[i] - mean);
+                }
+            }
+
+            statistics.spread = spread;
+        }
+
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        RegressionMetrics()  = delete;
+        ~RegressionMetrics() = delete;
+};
+
+#endif
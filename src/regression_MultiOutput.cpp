@@ -0,0 +1,333 @@
+#include <Rcpp.h>
+#include "regression_MultiOutput.h"
+using namespace Rcpp;
+
+//' @rdname multioutput
+//' @method mse matrix
+//' @export
+// [[Rcpp::export(mse.matrix)]]
+Rcpp::NumericVector mse_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::MEAN_SQUARED, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.mse matrix
+//' @export
+// [[Rcpp::export(weighted.mse.matrix)]]
+Rcpp::NumericVector weighted_mse_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::MEAN_SQUARED, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method rmse matrix
+//' @export
+// [[Rcpp::export(rmse.matrix)]]
+Rcpp::NumericVector rmse_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::ROOT_MEAN_SQUARED, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.rmse matrix
+//' @export
+// [[Rcpp::export(weighted.rmse.matrix)]]
+Rcpp::NumericVector weighted_rmse_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::ROOT_MEAN_SQUARED, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method mae matrix
+//' @export
+// [[Rcpp::export(mae.matrix)]]
+Rcpp::NumericVector mae_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::MEAN_ABSOLUTE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.mae matrix
+//' @export
+// [[Rcpp::export(weighted.mae.matrix)]]
+Rcpp::NumericVector weighted_mae_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::MEAN_ABSOLUTE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method mape matrix
+//' @export
+// [[Rcpp::export(mape.matrix)]]
+Rcpp::NumericVector mape_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::MEAN_ABSOLUTE_PERCENTAGE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.mape matrix
+//' @export
+// [[Rcpp::export(weighted.mape.matrix)]]
+Rcpp::NumericVector weighted_mape_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::MEAN_ABSOLUTE_PERCENTAGE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method smape matrix
+//' @export
+// [[Rcpp::export(smape.matrix)]]
+Rcpp::NumericVector smape_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::SYMMETRIC_MEAN_ABSOLUTE_PERCENTAGE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.smape matrix
+//' @export
+// [[Rcpp::export(weighted.smape.matrix)]]
+Rcpp::NumericVector weighted_smape_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::SYMMETRIC_MEAN_ABSOLUTE_PERCENTAGE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method mpe matrix
+//' @export
+// [[Rcpp::export(mpe.matrix)]]
+Rcpp::NumericVector mpe_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::MEAN_PERCENTAGE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.mpe matrix
+//' @export
+// [[Rcpp::export(weighted.mpe.matrix)]]
+Rcpp::NumericVector weighted_mpe_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::MEAN_PERCENTAGE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method rmsle matrix
+//' @export
+// [[Rcpp::export(rmsle.matrix)]]
+Rcpp::NumericVector rmsle_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::ROOT_MEAN_SQUARED_LOGARITHMIC, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.rmsle matrix
+//' @export
+// [[Rcpp::export(weighted.rmsle.matrix)]]
+Rcpp::NumericVector weighted_rmsle_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::ROOT_MEAN_SQUARED_LOGARITHMIC, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method rsq matrix
+//' @export
+// [[Rcpp::export(rsq.matrix)]]
+Rcpp::NumericVector rsq_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    double k = 0.0,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::DETERMINATION, multioutput, output_weights, 1.0, k);
+}
+
+//' @rdname multioutput
+//' @method weighted.rsq matrix
+//' @export
+// [[Rcpp::export(weighted.rsq.matrix)]]
+Rcpp::NumericVector weighted_rsq_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    double k = 0.0,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::DETERMINATION, multioutput, output_weights, 1.0, k);
+}
+
+//' @rdname multioutput
+//' @method rae matrix
+//' @export
+// [[Rcpp::export(rae.matrix)]]
+Rcpp::NumericVector rae_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::RELATIVE_ABSOLUTE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.rae matrix
+//' @export
+// [[Rcpp::export(weighted.rae.matrix)]]
+Rcpp::NumericVector weighted_rae_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::RELATIVE_ABSOLUTE, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method rrse matrix
+//' @export
+// [[Rcpp::export(rrse.matrix)]]
+Rcpp::NumericVector rrse_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::ROOT_RELATIVE_SQUARED, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method weighted.rrse matrix
+//' @export
+// [[Rcpp::export(weighted.rrse.matrix)]]
+Rcpp::NumericVector weighted_rrse_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::ROOT_RELATIVE_SQUARED, multioutput, output_weights);
+}
+
+//' @rdname multioutput
+//' @method huberloss matrix
+//' @export
+// [[Rcpp::export(huberloss.matrix)]]
+Rcpp::NumericVector huberloss_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    double delta = 1.0,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::HUBER, multioutput, output_weights, delta);
+}
+
+//' @rdname multioutput
+//' @method weighted.huberloss matrix
+//' @export
+// [[Rcpp::export(weighted.huberloss.matrix)]]
+Rcpp::NumericVector weighted_huberloss_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    double delta = 1.0,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::HUBER, multioutput, output_weights, delta);
+}
+
+//' @rdname multioutput
+//' @method ccc matrix
+//' @export
+// [[Rcpp::export(ccc.matrix)]]
+Rcpp::NumericVector ccc_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    bool correction = false,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, nullptr, RegressionMetrics::CONCORDANCE, multioutput, output_weights, 1.0, 0.0, correction);
+}
+
+//' @rdname multioutput
+//' @method weighted.ccc matrix
+//' @export
+// [[Rcpp::export(weighted.ccc.matrix)]]
+Rcpp::NumericVector weighted_ccc_matrix(
+    const Rcpp::NumericMatrix& actual,
+    const Rcpp::NumericMatrix& predicted,
+    const Rcpp::NumericVector& w,
+    bool correction = false,
+    std::string multioutput = "uniform_average",
+    Rcpp::Nullable<Rcpp::NumericVector> output_weights = R_NilValue)
+{
+    return MultiOutput::compute(actual, predicted, &w, RegressionMetrics::CONCORDANCE, multioutput, output_weights, 1.0, 0.0, correction);
+}
@@ -0,0 +1,184 @@
+#ifndef REGRESSION_MULTIOUTPUT_H
+#define REGRESSION_MULTIOUTPUT_H
+
+#include <Rcpp.h>
+#include "utilities_Package.h"
+#include "regression_Metrics.h"
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @class MultiOutput
+ * @brief Regression metrics of the columns of n x k matrices.
+ *
+ * Each column of `actual` and `predicted` is an output, and the metric of
+ * each output is computed from the sufficient statistics of RegressionMetrics
+ * over the contiguous (column-major) data of the column. The columns are
+ * distributed over the threads; if there are fewer columns than threads the
+ * columns are computed in turn, and each scan is parallel over the rows.
+ *
+ * The values of the outputs are returned as they are (raw_values), or
+ * averaged with the output weights (uniform_average) or with the output
+ * weights times the (weighted) variance of each column of `actual`
+ * (variance_weighted), as in scikit-learn.
+ */
+class MultiOutput {
+    public:
+        enum aggregation_type {
+            RAW_VALUES = 0,
+            UNIFORM_AVERAGE,
+            VARIANCE_WEIGHTED
+        };
+
+        /**
+        * Compute a metric of each output.
+        *
+        * @param actual         The n x k matrix of actual values.
+        * @param predicted      The n x k matrix of predicted values.
+        * @param weights        Optional vector of n observation weights.
+        * @param metric         The RegressionMetrics::metric_type.
+        * @param multioutput    One of "raw_values", "uniform_average" and "variance_weighted".
+        * @param output_weights Optional vector of k output weights.
+        * @param delta          The threshold of the Huber loss.
+        * @param k              The number of predictors of the adjusted R^2.
+        * @param correction     If true, the CCC is computed with the (n - 1) / n correction.
+        * @return               The k values, or their average.
+        */
+        static Rcpp::NumericVector compute(
+            const Rcpp::NumericMatrix& actual,
+            const Rcpp::NumericMatrix& predicted,
+            const Rcpp::NumericVector* weights,
+            int metric,
+            const std::string& multioutput,
+            const Rcpp::Nullable<Rcpp::NumericVector>& output_weights,
+            double delta = 1.0,
+            double k = 0.0,
+            bool correction = false)
+        {
+            const std::size_t n_rows { static_cast<std::size_t>(actual.nrow()) };
+            const std::size_t n_cols { static_cast<std::size_t>(actual.ncol()) };
+            const int type { aggregation(multioutput) };
+
+            // 1) validate the
+            //    dimensions
+            if (predicted.nrow() != actual.nrow() || predicted.ncol() != actual.ncol()) {
+                Rcpp::stop("`actual` and `predicted` must have the same dimensions.");
+            }
+
+            if (weights && static_cast<std::size_t>(weights->size()) != n_rows) {
+                Rcpp::stop("`w` must have length equal to the number of rows.");
+            }
+
+            std::vector<double> scale(n_cols, 1.0);
+            if (output_weights.isNotNull()) {
+                const Rcpp::NumericVector values(output_weights);
+                if (static_cast<std::size_t>(values.size()) != n_cols) {
+                    Rcpp::stop("`output_weights` must have length equal to the number of columns.");
+                }
+                scale.assign(values.begin(), values.end());
+            }
+
+            // 2) the metric and the
+            //    variance of each output
+            std::vector<double> values(n_cols), variances(n_cols);
+            compute(
+                actual.begin(),
+                predicted.begin(),
+                weights ? weights->begin() : nullptr,
+                n_rows,
+                n_cols,
+                metric,
+                type == VARIANCE_WEIGHTED,
+                delta,
+                k,
+                correction,
+                values.data(),
+                variances.data()
+            );
+
+            // 3) the raw values are
+            //    named by the columns
+            if (type == RAW_VALUES) {
+                Rcpp::NumericVector output(values.begin(), values.end());
+
+                Rcpp::RObject dimnames { actual.attr("dimnames") };
+                if (!Rf_isNull(dimnames) && !Rf_isNull(VECTOR_ELT(dimnames, 1))) {
+                    output.attr("names") = VECTOR_ELT(dimnames, 1);
+                }
+
+                return output;
+            }
+
+            // 4) the weighted average
+            //    of the outputs
+            double sum = 0.0, sum_w = 0.0;
+            for (std::size_t j = 0; j < n_cols; j++) {
+                const double w { type == VARIANCE_WEIGHTED ? scale[j] * variances[j] : scale[j] };
+
+                sum   += w * values[j];
+                sum_w += w;
+            }
+
+            return Rcpp::NumericVector::create(sum / sum_w);
+        }
+
+        /**
+        * Compute a metric of each column of the column-major
+        * n x k matrices into `values`, and the weighted sum of
+        * squares of each column of `actual` into `variances`.
+        */
+        static void compute(
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            std::size_t k,
+            int metric,
+            bool variance,
+            double delta,
+            double k_predictors,
+            bool correction,
+            double* values,
+            double* variances)
+        {
+            const unsigned plan {
+                RegressionMetrics::plan({ metric }) | (variance ? RegressionMetrics::ACTUAL : 0u)
+            };
+
+            #ifdef _OPENMP
+                #pragma omp parallel for schedule(dynamic) if(getUseOpenMP() && k >= static_cast<std::size_t>(omp_get_max_threads()))
+            #endif
+            for (std::size_t j = 0; j < k; j++) {
+                const RegressionStatistics statistics {
+                    RegressionMetrics::scan(actual + j * n, predicted + j * n, weights, n, plan, delta)
+                };
+
+                values[j]    = RegressionMetrics::value(statistics, metric, weights != nullptr, k_predictors, correction);
+                variances[j] = statistics.moments.m2_x;
+            }
+        }
+
+    private:
+        // map the name
+        // to the aggregation
+        static int aggregation(const std::string& name)
+        {
+            if (name == "raw_values")        return RAW_VALUES;
+            if (name == "uniform_average")   return UNIFORM_AVERAGE;
+            if (name == "variance_weighted") return VARIANCE_WEIGHTED;
+
+            Rcpp::stop("`multioutput` must be one of \"raw_values\", \"uniform_average\" and \"variance_weighted\".");
+        }
+
+        // Prevents the compiler from doing
+        // bad stuff.
+        MultiOutput()  = delete;
+        ~MultiOutput() = delete;
+};
+
+#endif
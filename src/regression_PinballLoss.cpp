@@ -1,64 +1,110 @@
 #include <Rcpp.h>
 #include "regression_PinballLoss.h"
+#include "regression_QuantileScore.h"
 using namespace Rcpp;
 
 //' @rdname pinball
 //' @method pinball numeric
 //' @export
 // [[Rcpp::export(pinball.numeric)]]
-double pinball(const Rcpp::NumericVector& actual,
-               const Rcpp::NumericVector& predicted,
-               double alpha = 0.5,
-               bool deviance = false)
+Rcpp::NumericVector pinball(const Rcpp::NumericVector& actual,
+                            const Rcpp::NumericVector& predicted,
+                            const Rcpp::NumericVector& alpha = Rcpp::NumericVector::create(0.5),
+                            bool deviance = false)
 {
+    // 0) A matrix of predicted quantiles
+    //    is scored in one pass
+    if (predicted.hasAttribute("dim")) {
+        return QuantileScore::pinball(actual, Rcpp::as<Rcpp::NumericMatrix>(predicted), nullptr, alpha, deviance);
+    }
+
+    if (alpha.size() != 1) {
+        Rcpp::stop("`alpha` must have length 1 unless `predicted` is a matrix.");
+    }
+
     // 1) Extract pointers
     const double* ptr_actual    = actual.begin();
     const double* ptr_predicted = predicted.begin();
+    const double level          = alpha[0];
     std::size_t n = actual.size();
 
     // 2) If not deviance, compute plain pinball loss (unweighted)
     if (!deviance) {
-        return PinballLoss::compute(ptr_actual, ptr_predicted, n, alpha);
+        return Rcpp::NumericVector::create(PinballLoss::compute(ptr_actual, ptr_predicted, n, level));
     }
 
     // 3) deviance = 1 - (pinball_loss / quantile_loss)
     //    where quantile_loss is the pinball loss if we predicted
     //    the alpha-quantile of `actual`.
-    double qValue = PinballLoss::quantile(ptr_actual, n, alpha);
+    double qValue = PinballLoss::quantile(ptr_actual, n, level);
 
-    double qLoss  = PinballLoss::computeConstantPred(ptr_actual, n, alpha, qValue);
-    double pLoss  = PinballLoss::compute(ptr_actual, ptr_predicted, n, alpha);
+    double qLoss  = PinballLoss::computeConstantPred(ptr_actual, n, level, qValue);
+    double pLoss  = PinballLoss::compute(ptr_actual, ptr_predicted, n, level);
 
-    return 1.0 - (pLoss / qLoss);
+    return Rcpp::NumericVector::create(1.0 - (pLoss / qLoss));
 }
 
 //' @rdname pinball
 //' @method weighted.pinball numeric
 //' @export
 // [[Rcpp::export(weighted.pinball.numeric)]]
-double weighted_pinball(const Rcpp::NumericVector& actual,
-                        const Rcpp::NumericVector& predicted,
-                        const Rcpp::NumericVector& w,
-                        double alpha = 0.5,
-                        bool deviance = false)
+Rcpp::NumericVector weighted_pinball(const Rcpp::NumericVector& actual,
+                                     const Rcpp::NumericVector& predicted,
+                                     const Rcpp::NumericVector& w,
+                                     const Rcpp::NumericVector& alpha = Rcpp::NumericVector::create(0.5),
+                                     bool deviance = false)
 {
+    // 0) A matrix of predicted quantiles
+    //    is scored in one pass
+    if (predicted.hasAttribute("dim")) {
+        return QuantileScore::pinball(actual, Rcpp::as<Rcpp::NumericMatrix>(predicted), &w, alpha, deviance);
+    }
+
+    if (alpha.size() != 1) {
+        Rcpp::stop("`alpha` must have length 1 unless `predicted` is a matrix.");
+    }
+
     // 1) Extract pointers
     const double* ptr_actual    = actual.begin();
     const double* ptr_predicted = predicted.begin();
     const double* ptr_w         = w.begin();
+    const double level          = alpha[0];
     std::size_t n = actual.size();
 
     // 2) If not deviance, compute plain pinball loss (weighted)
     if (!deviance) {
-        return PinballLoss::compute(ptr_actual, ptr_predicted, ptr_w, n, alpha);
+        return Rcpp::NumericVector::create(PinballLoss::compute(ptr_actual, ptr_predicted, ptr_w, n, level));
     }
 
     // 3) deviance
     //    quantile_loss = pinball loss using the weighted alpha-quantile
-    double qValue = PinballLoss::quantile(ptr_actual, ptr_w, n, alpha);
+    double qValue = PinballLoss::quantile(ptr_actual, ptr_w, n, level);
 
-    double qLoss  = PinballLoss::computeConstantPred(ptr_actual, ptr_w, n, alpha, qValue);
-    double pLoss  = PinballLoss::compute(ptr_actual, ptr_predicted, ptr_w, n, alpha);
+    double qLoss  = PinballLoss::computeConstantPred(ptr_actual, ptr_w, n, level, qValue);
+    double pLoss  = PinballLoss::compute(ptr_actual, ptr_predicted, ptr_w, n, level);
 
-    return 1.0 - (pLoss / qLoss);
+    return Rcpp::NumericVector::create(1.0 - (pLoss / qLoss));
+}
+
+//' @rdname interval.score
+//' @method interval.score numeric
+//' @export
+// [[Rcpp::export(interval.score.numeric)]]
+Rcpp::DataFrame interval_score(const Rcpp::NumericVector& actual,
+                               const Rcpp::NumericMatrix& predicted,
+                               const Rcpp::NumericVector& alpha)
+{
+    return QuantileScore::interval(actual, predicted, nullptr, alpha);
+}
+
+//' @rdname interval.score
+//' @method weighted.interval.score numeric
+//' @export
+// [[Rcpp::export(weighted.interval.score.numeric)]]
+Rcpp::DataFrame weighted_interval_score(const Rcpp::NumericVector& actual,
+                                        const Rcpp::NumericMatrix& predicted,
+                                        const Rcpp::NumericVector& w,
+                                        const Rcpp::NumericVector& alpha)
+{
+    return QuantileScore::interval(actual, predicted, &w, alpha);
 }
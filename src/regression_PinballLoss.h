@@ -2,6 +2,8 @@
 #define REGRESSION_PINBALLLOSS_H
 
 #include "utilities_Package.h"
+#include "utilities_SIMD.h"
+#include "utilities_Quantile.h"
 #include <cstddef>             
 #include <cmath>                
 #include <algorithm>            
@@ -30,21 +32,10 @@ public:
                           std::size_t n,
                           double alpha)
     {
-        double sumLoss = 0.0;
-
-        #ifdef _OPENMP
-            #pragma omp parallel for reduction(+:sumLoss) if(getUseOpenMP())
-        #endif
-        for (std::size_t i = 0; i < n; ++i) {
-            double diff = actual[i] - predicted[i];
-            if (diff >= 0.0) {
-                sumLoss += alpha * diff;
-            } else {
-                sumLoss += (1.0 - alpha) * (-diff);
-            }
-        }
+        double weight  = 0.0;
+        double sumLoss = SIMD::reduce(SIMD::kernels().pinball, actual, predicted, nullptr, n, alpha, weight);
 
-        return sumLoss / static_cast<double>(n);
+        return sumLoss / weight;
     }
 
     /**
@@ -65,22 +56,8 @@ public:
                           std::size_t n,
                           double alpha)
     {
-        double sumLoss = 0.0;
         double sumW    = 0.0;
-
-        #ifdef _OPENMP
-            #pragma omp parallel for reduction(+:sumLoss, sumW) if(getUseOpenMP())
-        #endif
-        for (std::size_t i = 0; i < n; ++i) {
-            double w    = weights[i];
-            double diff = actual[i] - predicted[i];
-            double val  = (diff >= 0.0)
-                            ? (alpha * diff)
-                            : ((1.0 - alpha) * -diff);
-
-            sumLoss += w * val;
-            sumW    += w;
-        }
+        double sumLoss = SIMD::reduce(SIMD::kernels().pinball, actual, predicted, weights, n, alpha, sumW);
 
         return sumLoss / sumW;
     }
@@ -152,32 +129,13 @@ public:
         return sumLoss / sumW;
     }
 
+    // the quantiles are selected
+    // without sorting; see Quantile
     static double quantile(const double* x,
                            std::size_t n,
                            double alpha)
     {
-        // Create an index array [0..n-1]
-        std::vector<std::size_t> idx(n);
-        for (std::size_t i = 0; i < n; ++i) {
-            idx[i] = i;
-        }
-
-        // Sort indices by x[idx[i]]
-        std::sort(idx.begin(), idx.end(),
-                  [&](std::size_t a, std::size_t b) {
-                      return x[a] < x[b];
-                  });
-
-        // Position in the sorted array
-        double pos = alpha * (n - 1);
-        std::size_t lower_i = static_cast<std::size_t>(pos);
-        std::size_t upper_i = (lower_i + 1 < n) ? (lower_i + 1) : (n - 1);
-        double frac = pos - static_cast<double>(lower_i);
-
-        double lower_val = x[idx[lower_i]];
-        double upper_val = x[idx[upper_i]];
-
-        return lower_val + frac * (upper_val - lower_val);
+        return Quantile::compute(x, n, alpha);
     }
 
     static double quantile(const double* x,
@@ -185,46 +143,7 @@ public:
                            std::size_t n,
                            double alpha)
     {
-        // Create an index array [0..n-1]
-        std::vector<std::size_t> idx(n);
-        for (std::size_t i = 0; i < n; ++i) {
-            idx[i] = i;
-        }
-
-        // Sort indices by the underlying value x[idx]
-        std::sort(idx.begin(), idx.end(),
-                  [&](std::size_t a, std::size_t b) {
-                      return x[a] < x[b];
-                  });
-
-        // Total weight
-        double totalW = 0.0;
-        for (std::size_t i = 0; i < n; ++i) {
-            totalW += w[i];
-        }
-
-        double target = alpha * totalW;
-        double cumW   = 0.0;
-        double lower_val = 0.0, upper_val = 0.0;
-        bool found_lower = false;
-
-        for (std::size_t i = 0; i < n; ++i) {
-            std::size_t ndx  = idx[i];
-            cumW += w[ndx];
-
-            // The moment we cross target, store 'lower_val'
-            if (!found_lower && cumW >= target) {
-                lower_val   = x[ndx];
-                found_lower = true;
-            }
-            // We store 'upper_val' as well
-            if (cumW >= target) {
-                upper_val = x[ndx];
-                break;
-            }
-        }
-
-        return lower_val; 
+        return Quantile::compute(x, w, n, alpha);
     }
 
     private:
@@ -0,0 +1,347 @@
+#ifndef REGRESSION_QUANTILESCORE_H
+#define REGRESSION_QUANTILESCORE_H
+
+#include <Rcpp.h>
+#include "utilities_Package.h"
+#include "utilities_Quantile.h"
+#include "regression_PinballLoss.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <numeric>
+#include <utility>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @class QuantileScore
+ * @brief Scores of an n x q matrix of predicted quantiles in one pass.
+ *
+ * Column j of `predicted` is the predicted alpha_j-quantile of each
+ * observation. The rows are processed in blocks, and for each block the
+ * pinball loss of every column, the interval statistics of every pair of
+ * columns (alpha, 1 - alpha) with 0 < alpha < 0.5, and the rows whose quantiles
+ * cross are accumulated while the block is in cache. The interval of the
+ * pair is [l, u] with the nominal coverage 1 - beta, beta = 2 * alpha, and
+ *
+ *   coverage = sum(w * (l <= a <= u)) / sum(w)
+ *   width    = sum(w * (u - l)) / sum(w)
+ *   winkler  = sum(w * ((u - l) + (2 / beta) * (max(l - a, 0) + max(a - u, 0)))) / sum(w)
+ *
+ * The quantiles of a row cross if they are not non-decreasing in alpha.
+ */
+class QuantileScore {
+    public:
+        /**
+        * @brief The (weighted) sums of the scores.
+        */
+        struct Scores {
+            double weight   = 0.0;           // sum(w)
+            double crossing = 0.0;           // sum(w) of the rows with crossing quantiles
+            std::vector<double> pinball;     // sum(w * pinball) of each column
+            std::vector<double> covered;     // sum(w * covered) of each pair
+            std::vector<double> width;       // sum(w * width) of each pair
+            std::vector<double> winkler;     // sum(w * winkler) of each pair
+
+            Scores(std::size_t q = 0, std::size_t pairs = 0)
+                : pinball(q, 0.0), covered(pairs, 0.0), width(pairs, 0.0), winkler(pairs, 0.0) {}
+
+            void merge(const Scores& other) {
+                weight   += other.weight;
+                crossing += other.crossing;
+                for (std::size_t j = 0; j < pinball.size(); j++) pinball[j] += other.pinball[j];
+                for (std::size_t j = 0; j < covered.size(); j++) {
+                    covered[j] += other.covered[j];
+                    width[j]   += other.width[j];
+                    winkler[j] += other.winkler[j];
+                }
+            }
+        };
+
+        /**
+        * Accumulate the scores of all columns and pairs.
+        *
+        * @param actual    Pointer to the n actual values.
+        * @param predicted Pointer to the column-major n x q predicted quantiles.
+        * @param weights   Pointer to weights; nullptr if unweighted.
+        * @param n         Number of observations.
+        * @param alpha     The q quantile levels of the columns.
+        * @param pairs     The (lower, upper) columns of the intervals.
+        */
+        static Scores compute(
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            const std::vector<double>& alpha,
+            const std::vector<std::pair<std::size_t, std::size_t>>& pairs)
+        {
+            const std::size_t q { alpha.size() };
+            const std::size_t n_blocks { (n + block_size - 1) / block_size };
+
+            // the columns in
+            // the order of alpha
+            std::vector<std::size_t> order(q);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [&alpha](std::size_t x, std::size_t y) { return alpha[x] < alpha[y]; });
+
+            Scores scores(q, pairs.size());
+
+            #ifdef _OPENMP
+                #pragma omp parallel if(getUseOpenMP())
+            #endif
+            {
+                Scores local(q, pairs.size());
+                unsigned char crossed[block_size];
+
+                #ifdef _OPENMP
+                    #pragma omp for schedule(static)
+                #endif
+                for (std::size_t b = 0; b < n_blocks; b++) {
+                    const std::size_t first { b * block_size };
+                    const std::size_t m     { std::min(n, first + block_size) - first };
+
+                    const double* a { actual + first };
+                    const double* w { weights ? weights + first : nullptr };
+
+                    auto weight = [w](std::size_t i) -> double { return w ? w[i] : 1.0; };
+
+                    // 1) the weights
+                    //    of the block
+                    double sum_w = 0.0;
+                    for (std::size_t i = 0; i < m; i++) sum_w += weight(i);
+                    local.weight += sum_w;
+
+                    // 2) the pinball loss
+                    //    of each column
+                    for (std::size_t j = 0; j < q; j++) {
+                        const double* p { predicted + j * n + first };
+                        const double level { alpha[j] };
+
+                        double sum = 0.0;
+                        for (std::size_t i = 0; i < m; i++) {
+                            const double d { a[i] - p[i] };
+                            sum += weight(i) * (d < 0.0 ? (level - 1.0) * d : level * d);
+                        }
+                        local.pinball[j] += sum;
+                    }
+
+                    // 3) the intervals
+                    //    of each pair
+                    for (std::size_t k = 0; k < pairs.size(); k++) {
+                        const double* l { predicted + pairs[k].first * n + first };
+                        const double* u { predicted + pairs[k].second * n + first };
+                        const double penalty { 2.0 / (2.0 * alpha[pairs[k].first]) };
+
+                        double covered = 0.0, width = 0.0, winkler = 0.0;
+                        for (std::size_t i = 0; i < m; i++) {
+                            const double range { u[i] - l[i] };
+                            const double below { std::max(l[i] - a[i], 0.0) };
+                            const double above { std::max(a[i] - u[i], 0.0) };
+
+                            covered += weight(i) * (below == 0.0 && above == 0.0 ? 1.0 : 0.0);
+                            width   += weight(i) * range;
+                            winkler += weight(i) * (range + penalty * (below + above));
+                        }
+
+                        local.covered[k] += covered;
+                        local.width[k]   += width;
+                        local.winkler[k] += winkler;
+                    }
+
+                    // 4) the rows with
+                    //    crossing quantiles
+                    if (q > 1) {
+                        std::fill(crossed, crossed + m, 0);
+                        for (std::size_t j = 1; j < q; j++) {
+                            const double* lower { predicted + order[j - 1] * n + first };
+                            const double* upper { predicted + order[j] * n + first };
+
+                            for (std::size_t i = 0; i < m; i++) crossed[i] |= (upper[i] < lower[i]);
+                        }
+
+                        double crossing = 0.0;
+                        for (std::size_t i = 0; i < m; i++) crossing += crossed[i] ? weight(i) : 0.0;
+                        local.crossing += crossing;
+                    }
+                }
+
+                #ifdef _OPENMP
+                    #pragma omp critical
+                #endif
+                {
+                    scores.merge(local);
+                }
+            }
+
+            return scores;
+        }
+
+        /**
+        * The pinball loss of each column of `predicted`, or the D^2 of each column.
+        *
+        * @param actual    Numeric vector of the n actual values.
+        * @param predicted Numeric n x q matrix of predicted quantiles.
+        * @param weights   Optional vector of observation weights.
+        * @param alpha     The q quantile levels of the columns.
+        * @param deviance  If true, the D^2 of each column is returned.
+        * @return          The q losses named by the levels, with the share of
+        *                  crossing rows in the `crossing` attribute.
+        */
+        static Rcpp::NumericVector pinball(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericMatrix& predicted,
+            const Rcpp::NumericVector* weights,
+            const Rcpp::NumericVector& alpha,
+            bool deviance)
+        {
+            const std::vector<double> levels { validate(actual, predicted, weights, alpha) };
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+            const double* w { weights ? weights->begin() : nullptr };
+
+            // 1) the scores
+            //    in one pass
+            const Scores scores { compute(actual.begin(), predicted.begin(), w, n, levels, {}) };
+
+            Rcpp::NumericVector output(levels.size());
+            for (std::size_t j = 0; j < levels.size(); j++) {
+                output[j] = scores.pinball[j] / scores.weight;
+            }
+
+            // 2) the D^2 against the
+            //    quantiles of `actual`
+            if (deviance) {
+                const std::vector<double> quantiles {
+                    w ? Quantile::compute([&actual](std::size_t i) { return actual[i]; }, [w](std::size_t i) { return w[i]; }, n, levels)
+                      : Quantile::compute([&actual](std::size_t i) { return actual[i]; }, n, levels)
+                };
+
+                for (std::size_t j = 0; j < levels.size(); j++) {
+                    const double loss {
+                        w ? PinballLoss::computeConstantPred(actual.begin(), w, n, levels[j], quantiles[j])
+                          : PinballLoss::computeConstantPred(actual.begin(), n, levels[j], quantiles[j])
+                    };
+
+                    output[j] = 1.0 - output[j] / loss;
+                }
+            }
+
+            output.attr("names")    = Quantile::labels(levels);
+            output.attr("crossing") = scores.crossing / scores.weight;
+
+            return output;
+        }
+
+        /**
+        * The coverage, width and Winkler score of each central interval.
+        *
+        * @param actual    Numeric vector of the n actual values.
+        * @param predicted Numeric n x q matrix of predicted quantiles.
+        * @param weights   Optional vector of observation weights.
+        * @param alpha     The q quantile levels of the columns.
+        * @return          A data.frame with one row per pair (alpha, 1 - alpha), 0 < alpha < 0.5,
+        *                  with the share of crossing rows in the `crossing` attribute.
+        */
+        static Rcpp::DataFrame interval(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericMatrix& predicted,
+            const Rcpp::NumericVector* weights,
+            const Rcpp::NumericVector& alpha)
+        {
+            const std::vector<double> levels { validate(actual, predicted, weights, alpha) };
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+
+            // 1) the pairs of central quantiles; the
+            //    pair (0, 1) is unbounded, and its
+            //    Winkler score is not defined
+            std::vector<std::pair<std::size_t, std::size_t>> pairs;
+            for (std::size_t j = 0; j < levels.size(); j++) {
+                if (!(levels[j] > 0.0 && levels[j] < 0.5)) continue;
+
+                for (std::size_t k = 0; k < levels.size(); k++) {
+                    if (std::fabs(levels[k] - (1.0 - levels[j])) < 1e-9) {
+                        pairs.emplace_back(j, k);
+                        break;
+                    }
+                }
+            }
+
+            if (pairs.empty()) {
+                Rcpp::stop("`alpha` must have at least one pair of levels alpha and 1 - alpha, with alpha in (0, 0.5).");
+            }
+
+            std::sort(pairs.begin(), pairs.end(), [&levels](const auto& x, const auto& y) { return levels[x.first] > levels[y.first]; });
+
+            // 2) the scores
+            //    in one pass
+            const Scores scores { compute(actual.begin(), predicted.begin(), weights ? weights->begin() : nullptr, n, levels, pairs) };
+
+            const std::size_t k { pairs.size() };
+            Rcpp::NumericVector nominal(k), lower(k), upper(k), coverage(k), width(k), winkler(k);
+            for (std::size_t j = 0; j < k; j++) {
+                nominal[j]  = 1.0 - 2.0 * levels[pairs[j].first];
+                lower[j]    = levels[pairs[j].first];
+                upper[j]    = levels[pairs[j].second];
+                coverage[j] = scores.covered[j] / scores.weight;
+                width[j]    = scores.width[j] / scores.weight;
+                winkler[j]  = scores.winkler[j] / scores.weight;
+            }
+
+            Rcpp::DataFrame output = Rcpp::DataFrame::create(
+                Rcpp::Named("nominal")  = nominal,
+                Rcpp::Named("lower")    = lower,
+                Rcpp::Named("upper")    = upper,
+                Rcpp::Named("coverage") = coverage,
+                Rcpp::Named("width")    = width,
+                Rcpp::Named("winkler")  = winkler
+            );
+            output.attr("crossing") = scores.crossing / scores.weight;
+
+            return output;
+        }
+
+    private:
+        // rows per block; the block of
+        // all q columns stays in cache
+        static constexpr std::size_t block_size = 1024;
+
+        // validate the
+        // dimensions and levels
+        static std::vector<double> validate(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericMatrix& predicted,
+            const Rcpp::NumericVector* weights,
+            const Rcpp::NumericVector& alpha)
+        {
+            if (predicted.nrow() != actual.size()) {
+                Rcpp::stop("`predicted` must have one row per element of `actual`.");
+            }
+
+            if (alpha.size() != predicted.ncol()) {
+                Rcpp::stop("`alpha` must have one level per column of `predicted`.");
+            }
+
+            if (weights && weights->size() != actual.size()) {
+                Rcpp::stop("`w` must have the same length as `actual`.");
+            }
+
+            std::vector<double> levels(alpha.begin(), alpha.end());
+            for (double a : levels) {
+                if (!(a >= 0.0 && a <= 1.0)) {
+                    Rcpp::stop("`alpha` must be in [0, 1].");
+                }
+            }
+
+            return levels;
+        }
+
+        // Prevents the compiler from doing
+        // bad stuff.
+        QuantileScore()  = delete;
+        ~QuantileScore() = delete;
+};
+
+#endif
@@ -24,6 +24,10 @@ class RAE {
         {
             // 1) Compute mean of actual
             double sum_actual = 0.0;
+
+            #ifdef _OPENMP
+                #pragma omp parallel for reduction(+:sum_actual) if(getUseOpenMP())
+            #endif
             for (std::size_t i = 0; i < n; ++i) {
                 sum_actual += actual[i];
             }
@@ -65,6 +69,10 @@ class RAE {
             // 1) Compute weighted mean of actual
             double weighted_sum = 0.0;
             double weight_sum   = 0.0;
+
+            #ifdef _OPENMP
+                #pragma omp parallel for reduction(+:weighted_sum, weight_sum) if(getUseOpenMP())
+            #endif
             for (std::size_t i = 0; i < n; ++i) {
                 weighted_sum += weights[i] * actual[i];
                 weight_sum   += weights[i];
@@ -3,6 +3,7 @@
 
 #include <Rcpp.h>
 #include "utilities_Package.h"
+#include "utilities_Quantile.h"
 #include <cmath>
 #include <cstddef>
 #include <algorithm>
@@ -16,7 +17,7 @@ class RRMSE {
     public:
 
         /**
-        * Compute unweighted RRMSE in one pass for RMSE, plus partial pass for IQR if needed.
+        * Compute unweighted RRMSE in one pass for RMSE, plus a selection pass for IQR if needed.
         *
         * Normalization:
         *   0 -> Mean
@@ -91,7 +92,7 @@ class RRMSE {
                 normFactor = (maxVal - minVal);
                 break;
 
-            case 2: // IQR -> needs sorting, hence a copy is unavoidable
+            case 2: // IQR
                 normFactor = unweightedIQR(actual, n);
                 break;
 
@@ -197,7 +198,7 @@ class RRMSE {
                 normFactor = (maxVal - minVal);
                 break;
 
-            case 2: // weighted IQR -> requires sorting
+            case 2: // weighted IQR
                 normFactor = weightedIQR(actual, weights, n);
                 break;
 
@@ -212,78 +213,27 @@ class RRMSE {
 
     private:
 
+        // the quartiles are selected
+        // without sorting, and from the
+        // same pass; see Quantile
         static double unweightedIQR(const double* values, std::size_t n)
         {
-            // Copy once (last resort) because we must sort for quantiles:
-            std::vector<double> tmp(values, values + n);
-            std::sort(tmp.begin(), tmp.end());
+            const std::vector<double> quartiles {
+                Quantile::compute([values](std::size_t i) { return values[i]; }, n, { 0.25, 0.75 })
+            };
 
-            double q1 = unweightedQuantileSorted(tmp, 0.25);
-            double q3 = unweightedQuantileSorted(tmp, 0.75);
-            return (q3 - q1);
+            return quartiles[1] - quartiles[0];
         }
 
-
         static double weightedIQR(const double* values,
                                 const double* weights,
                                 std::size_t n)
         {
-            
-            std::vector<std::pair<double,double>> vw;
-            vw.reserve(n);
-            for (std::size_t i = 0; i < n; ++i) {
-                vw.emplace_back(values[i], weights[i]);
-            }
-            
-            std::sort(vw.begin(), vw.end(),
-                    [](auto &a, auto &b){ return a.first < b.first; });
-
-            double q1 = weightedQuantileSorted(vw, 0.25);
-            double q3 = weightedQuantileSorted(vw, 0.75);
-            return (q3 - q1);
-        }
-
-        static double unweightedQuantileSorted(const std::vector<double> &sortedVals,
-                                            double alpha)
-        {
-            // No checks for n>1, alpha in [0,1], etc., per user request
-            std::size_t n = sortedVals.size();
-            double pos = alpha * (n - 1);
-            std::size_t idxLower = static_cast<std::size_t>(pos);
-            std::size_t idxUpper = (idxLower + 1 < n) ? (idxLower + 1) : (n - 1);
-            double frac = pos - static_cast<double>(idxLower);
-
-            double valLower = sortedVals[idxLower];
-            double valUpper = sortedVals[idxUpper];
-            return valLower + (valUpper - valLower) * frac;
-        }
+            const std::vector<double> quartiles {
+                Quantile::compute([values](std::size_t i) { return values[i]; }, [weights](std::size_t i) { return weights[i]; }, n, { 0.25, 0.75 })
+            };
 
-        static double weightedQuantileSorted(const std::vector<std::pair<double,double>> &vw,
-                                            double alpha)
-        {
-            // Sum all weights
-            double totalW = 0.0;
-            for (auto &p : vw) {
-                totalW += p.second;
-            }
-            double target = alpha * totalW;
-
-            double cumW = 0.0;
-            double prevVal = vw[0].first;
-            for (auto &p : vw) {
-                double val = p.first;
-                double w   = p.second;
-                cumW += w;
-
-                if (cumW >= target) {
-
-                    return val;
-
-                }
-                prevVal = val;
-            }
-            
-            return vw.back().first;
+            return quartiles[1] - quartiles[0];
         }
 
     private:
@@ -0,0 +1,75 @@
+#include <Rcpp.h>
+#include "regression_RobustError.h"
+using namespace Rcpp;
+
+//' @rdname medae
+//' @method medae numeric
+//' @export
+// [[Rcpp::export(medae.numeric)]]
+double medae(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted)
+{
+    return RobustError::quantile(actual.begin(), predicted.begin(), nullptr, actual.size(), { 0.5 }, RobustError::ABSOLUTE)[0];
+}
+
+//' @rdname medae
+//' @method weighted.medae numeric
+//' @export
+// [[Rcpp::export(weighted.medae.numeric)]]
+double weighted_medae(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w)
+{
+    return RobustError::quantile(actual.begin(), predicted.begin(), w.begin(), actual.size(), { 0.5 }, RobustError::ABSOLUTE)[0];
+}
+
+//' @rdname mdape
+//' @method mdape numeric
+//' @export
+// [[Rcpp::export(mdape.numeric)]]
+double mdape(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted)
+{
+    return RobustError::quantile(actual.begin(), predicted.begin(), nullptr, actual.size(), { 0.5 }, RobustError::ABSOLUTE_PERCENTAGE)[0];
+}
+
+//' @rdname mdape
+//' @method weighted.mdape numeric
+//' @export
+// [[Rcpp::export(weighted.mdape.numeric)]]
+double weighted_mdape(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w)
+{
+    return RobustError::quantile(actual.begin(), predicted.begin(), w.begin(), actual.size(), { 0.5 }, RobustError::ABSOLUTE_PERCENTAGE)[0];
+}
+
+//' @rdname ae.quantile
+//' @method ae.quantile numeric
+//' @export
+// [[Rcpp::export(ae.quantile.numeric)]]
+Rcpp::NumericVector ae_quantile(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& alpha = Rcpp::NumericVector::create(0.5, 0.9, 0.99))
+{
+    return RobustError::quantile(actual, predicted, nullptr, alpha, RobustError::ABSOLUTE);
+}
+
+//' @rdname ae.quantile
+//' @method weighted.ae.quantile numeric
+//' @export
+// [[Rcpp::export(weighted.ae.quantile.numeric)]]
+Rcpp::NumericVector weighted_ae_quantile(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w, const Rcpp::NumericVector& alpha = Rcpp::NumericVector::create(0.5, 0.9, 0.99))
+{
+    return RobustError::quantile(actual, predicted, &w, alpha, RobustError::ABSOLUTE);
+}
+
+//' @rdname ae.cvar
+//' @method ae.cvar numeric
+//' @export
+// [[Rcpp::export(ae.cvar.numeric)]]
+double ae_cvar(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, double alpha = 0.95)
+{
+    return RobustError::tail(actual, predicted, nullptr, alpha, RobustError::ABSOLUTE);
+}
+
+//' @rdname ae.cvar
+//' @method weighted.ae.cvar numeric
+//' @export
+// [[Rcpp::export(weighted.ae.cvar.numeric)]]
+double weighted_ae_cvar(const Rcpp::NumericVector& actual, const Rcpp::NumericVector& predicted, const Rcpp::NumericVector& w, double alpha = 0.95)
+{
+    return RobustError::tail(actual, predicted, &w, alpha, RobustError::ABSOLUTE);
+}
@@ -0,0 +1,177 @@
+#ifndef REGRESSION_ROBUSTERROR_H
+#define REGRESSION_ROBUSTERROR_H
+
+#include <Rcpp.h>
+#include "utilities_Package.h"
+#include "utilities_Quantile.h"
+#include <cmath>
+#include <cstddef>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @class RobustError
+ * @brief Quantiles and tail means of the error distribution.
+ *
+ * The errors are the absolute errors |a - p|, or the absolute percentage
+ * errors |a - p| / |a|. They are read through an accessor, so they are
+ * never stored, and all quantiles are selected from one pass over the
+ * rows with the selection of Quantile, which is shared with RRMSE.
+ *
+ * The unweighted quantiles are of type 7, and the weighted quantiles are
+ * the smallest errors whose cumulative weight reaches alpha * sum(w). The
+ * tail mean (CVaR) is the mean error above the alpha-quantile,
+ *
+ *   CVaR = q + sum(w * max(e - q, 0)) / ((1 - alpha) * sum(w))
+ *
+ * where q is the weighted quantile, with unit weights if unweighted.
+ */
+class RobustError {
+    public:
+        enum error_type {
+            ABSOLUTE = 0,
+            ABSOLUTE_PERCENTAGE
+        };
+
+        /**
+        * The quantiles of the errors.
+        *
+        * @param actual    Pointer to actual values.
+        * @param predicted Pointer to predicted values.
+        * @param weights   Pointer to weights; nullptr if unweighted.
+        * @param n         Number of observations.
+        * @param alpha     The quantile levels in [0, 1].
+        * @param type      The error.
+        */
+        static std::vector<double> quantile(
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            const std::vector<double>& alpha,
+            error_type type)
+        {
+            return dispatch<std::vector<double>>(actual, predicted, type, [&](auto error) {
+                if (weights) {
+                    return Quantile::compute(error, [weights](std::size_t i) { return weights[i]; }, n, alpha);
+                }
+
+                return Quantile::compute(error, n, alpha);
+            });
+        }
+
+        /**
+        * The tail mean of the errors above the alpha-quantile.
+        *
+        * @param actual    Pointer to actual values.
+        * @param predicted Pointer to predicted values.
+        * @param weights   Pointer to weights; nullptr if unweighted.
+        * @param n         Number of observations.
+        * @param alpha     The quantile level in [0, 1).
+        * @param type      The error.
+        */
+        static double tail(
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            double alpha,
+            error_type type)
+        {
+            return dispatch<double>(actual, predicted, type, [&](auto error) {
+                // 1) the weighted quantile;
+                //    unit weights if unweighted
+                auto weight = [weights](std::size_t i) { return weights ? weights[i] : 1.0; };
+                const double q { Quantile::compute(error, weight, n, alpha) };
+
+                // 2) the weighted excess
+                //    over the quantile
+                double excess = 0.0, total = 0.0;
+
+                #ifdef _OPENMP
+                    #pragma omp parallel for reduction(+:excess, total) if(getUseOpenMP())
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    const double e { error(i) };
+                    const double w { weight(i) };
+
+                    excess += w * (e > q ? e - q : 0.0);
+                    total  += w;
+                }
+
+                return q + excess / ((1.0 - alpha) * total);
+            });
+        }
+
+        /**
+        * The quantiles of the errors as a named vector;
+        * the names are the levels in percent, eg. "90%".
+        */
+        static Rcpp::NumericVector quantile(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericVector& predicted,
+            const Rcpp::NumericVector* weights,
+            const Rcpp::NumericVector& alpha,
+            error_type type)
+        {
+            // 1) validate the
+            //    levels
+            std::vector<double> levels(alpha.begin(), alpha.end());
+            for (double a : levels) {
+                if (!(a >= 0.0 && a <= 1.0)) {
+                    Rcpp::stop("`alpha` must be in [0, 1].");
+                }
+            }
+
+            // 2) the quantiles
+            const std::vector<double> quantiles {
+                quantile(actual.begin(), predicted.begin(), weights ? weights->begin() : nullptr, actual.size(), levels, type)
+            };
+            Rcpp::NumericVector output(quantiles.begin(), quantiles.end());
+
+            // 3) the names
+            output.attr("names") = Quantile::labels(levels);
+
+            return output;
+        }
+
+        /**
+        * The tail mean of the errors; see tail().
+        */
+        static double tail(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericVector& predicted,
+            const Rcpp::NumericVector* weights,
+            double alpha,
+            error_type type)
+        {
+            if (!(alpha >= 0.0 && alpha < 1.0)) {
+                Rcpp::stop("`alpha` must be in [0, 1).");
+            }
+
+            return tail(actual.begin(), predicted.begin(), weights ? weights->begin() : nullptr, actual.size(), alpha, type);
+        }
+
+    private:
+        // call f with the
+        // accessor of the error
+        template <typename Result, typename Function>
+        static Result dispatch(const double* actual, const double* predicted, error_type type, Function f)
+        {
+            if (type == ABSOLUTE_PERCENTAGE) {
+                return f([actual, predicted](std::size_t i) { return std::fabs(actual[i] - predicted[i]) / std::fabs(actual[i]); });
+            }
+
+            return f([actual, predicted](std::size_t i) { return std::fabs(actual[i] - predicted[i]); });
+        }
+
+        // Prevents the compiler from doing
+        // bad stuff.
+        RobustError()  = delete;
+        ~RobustError() = delete;
+};
+
+#endif
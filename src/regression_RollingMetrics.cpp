@@ -0,0 +1,40 @@
+#include <Rcpp.h>
+#include "regression_RollingMetrics.h"
+using namespace Rcpp;
+
+//' @rdname rolling
+//' @method rolling numeric
+//' @export
+// [[Rcpp::export(rolling.numeric)]]
+Rcpp::NumericMatrix rolling(
+    const Rcpp::NumericVector& actual,
+    const Rcpp::NumericVector& predicted,
+    int window = 10,
+    const Rcpp::CharacterVector& measures = Rcpp::CharacterVector::create("rmse", "mae", "mape", "bias", "rsq"),
+    std::string type = "sliding",
+    double alpha = 0.1,
+    double delta = 1.0,
+    double k = 0.0,
+    bool correction = false)
+{
+    return RollingMetrics::compute(actual, predicted, nullptr, window, measures, type, alpha, delta, k, correction);
+}
+
+//' @rdname rolling
+//' @method weighted.rolling numeric
+//' @export
+// [[Rcpp::export(weighted.rolling.numeric)]]
+Rcpp::NumericMatrix weighted_rolling(
+    const Rcpp::NumericVector& actual,
+    const Rcpp::NumericVector& predicted,
+    const Rcpp::NumericVector& w,
+    int window = 10,
+    const Rcpp::CharacterVector& measures = Rcpp::CharacterVector::create("rmse", "mae", "mape", "bias", "rsq"),
+    std::string type = "sliding",
+    double alpha = 0.1,
+    double delta = 1.0,
+    double k = 0.0,
+    bool correction = false)
+{
+    return RollingMetrics::compute(actual, predicted, &w, window, measures, type, alpha, delta, k, correction);
+}
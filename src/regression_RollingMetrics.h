@@ -0,0 +1,481 @@
+#ifndef REGRESSION_ROLLINGMETRICS_H
+#define REGRESSION_ROLLINGMETRICS_H
+
+#include <Rcpp.h>
+#include "utilities_Package.h"
+#include "regression_Metrics.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @struct CompensatedSum
+ * @brief A running sum with the compensation of Neumaier.
+ *
+ * The rounding error of each addition is carried in a separate term, so a
+ * sum that is updated by adding and subtracting the same values, as in a
+ * sliding window, does not drift.
+ */
+struct CompensatedSum {
+    double sum          = 0.0;
+    double compensation = 0.0;
+
+    void add(double x) {
+        const double t { sum + x };
+        compensation += std::fabs(sum) >= std::fabs(x) ? (sum - t) + x : (x - t) + sum;
+        sum = t;
+    }
+
+    void scale(double factor) {
+        sum          *= factor;
+        compensation *= factor;
+    }
+
+    double value() const {
+        return sum + compensation;
+    }
+};
+
+/**
+ * @class RollingMetrics
+ * @brief Regression metrics over sliding, expanding and exponentially weighted windows.
+ *
+ * The window holds the sufficient statistics of RegressionMetrics: the
+ * (weighted) sums of the losses, which are compensated sums, and the means
+ * and centered second moments of the actual and predicted values, which are
+ * updated as in Welford's algorithm when a row enters or leaves the window.
+ * The metric of each row is computed from the statistics of its window with
+ * RegressionMetrics::value(), so each row costs O(1):
+ *
+ *   sliding:     the last `window` rows; row i enters and row i - window leaves.
+ *   expanding:   all rows up to i.
+ *   exponential: all rows up to i, where row j has the weight (1 - alpha)^(i - j).
+ *
+ * The sliding windows are computed in parallel over blocks of `window` rows,
+ * and each block is warmed up with the `window` rows before it, so the blocks
+ * overlap and each block starts from fresh statistics. The statistics are
+ * thus updated at most 3 * window times, which bounds the drift of the
+ * moments of small windows, at twice the cost. The expanding and exponential
+ * windows are a scan; the statistics of each block are computed in parallel,
+ * carried over the blocks in order, and each block is then recomputed in
+ * parallel from the statistics carried into it.
+ */
+class RollingMetrics {
+    public:
+        enum window_type {
+            SLIDING = 0,
+            EXPANDING,
+            EXPONENTIAL
+        };
+
+        /**
+        * Compute the requested metrics of the window of each row.
+        *
+        * @param actual     Numeric vector of actual values.
+        * @param predicted  Numeric vector of predicted values.
+        * @param weights    Optional vector of observation weights.
+        * @param window     The number of rows in the sliding window.
+        * @param metrics    Character vector of metric names.
+        * @param type       One of "sliding", "expanding" and "exponential".
+        * @param alpha      The smoothing factor of the exponential window in (0, 1].
+        * @param delta      The threshold of the Huber loss.
+        * @param k          The number of predictors of the adjusted R^2.
+        * @param correction If true, the CCC is computed with the (n - 1) / n correction.
+        * @return           An n x m matrix; one row per observation and one column per metric.
+        */
+        static Rcpp::NumericMatrix compute(
+            const Rcpp::NumericVector& actual,
+            const Rcpp::NumericVector& predicted,
+            const Rcpp::NumericVector* weights,
+            int window,
+            const Rcpp::CharacterVector& metrics,
+            const std::string& type,
+            double alpha,
+            double delta = 1.0,
+            double k = 0.0,
+            bool correction = false)
+        {
+            const std::size_t n { static_cast<std::size_t>(actual.size()) };
+            const int method { window_method(type) };
+
+            // 1) validate the
+            //    arguments
+            if (static_cast<std::size_t>(predicted.size()) != n || (weights && static_cast<std::size_t>(weights->size()) != n)) {
+                Rcpp::stop("`actual`, `predicted` and `w` must have the same length.");
+            }
+
+            if (method == SLIDING && window < 1) {
+                Rcpp::stop("`window` must be a positive integer.");
+            }
+
+            if (method == EXPONENTIAL && !(alpha > 0.0 && alpha <= 1.0)) {
+                Rcpp::stop("`alpha` must be in (0, 1].");
+            }
+
+            // 2) map the names
+            //    to the metrics
+            std::vector<int> requested(metrics.size());
+            for (R_xlen_t m = 0; m < metrics.size(); m++) {
+                requested[m] = RegressionMetrics::metric(Rcpp::as<std::string>(metrics[m]));
+                if (requested[m] == RegressionMetrics::RELATIVE_ABSOLUTE) {
+                    Rcpp::stop("\"rae\" can not be updated in O(1) per row, and is not available in windows.");
+                }
+            }
+
+            // 3) the metrics of
+            //    each window
+            Rcpp::NumericMatrix output(static_cast<int>(n), static_cast<int>(requested.size()));
+            compute(
+                actual.begin(),
+                predicted.begin(),
+                weights ? weights->begin() : nullptr,
+                n,
+                method,
+                static_cast<std::size_t>(std::max(window, 1)),
+                alpha,
+                requested,
+                delta,
+                k,
+                correction,
+                output.begin()
+            );
+
+            output.attr("dimnames") = Rcpp::List::create(R_NilValue, metrics);
+
+            return output;
+        }
+
+        /**
+        * Compute the metrics of the window of each row into
+        * the column-major n x m matrix `output`; the rows of an
+        * incomplete sliding window are NA.
+        */
+        static void compute(
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            int method,
+            std::size_t window,
+            double alpha,
+            const std::vector<int>& metrics,
+            double delta,
+            double k,
+            bool correction,
+            double* output)
+        {
+            const Context context {
+                actual, predicted, weights, metrics, RegressionMetrics::plan(metrics),
+                delta, k, correction, method == EXPONENTIAL ? 1.0 - alpha : 1.0,
+                weights != nullptr || method == EXPONENTIAL, n, output
+            };
+
+            if (method == SLIDING) {
+                sliding(context, window);
+            } else {
+                scan(context);
+            }
+        }
+
+    private:
+        // rows per block
+        static constexpr std::size_t block_size = 4096;
+
+        // the inputs and
+        // outputs of a call
+        struct Context {
+            const double* actual;
+            const double* predicted;
+            const double* weights;
+            const std::vector<int>& metrics;
+            unsigned plan;
+            double delta;
+            double k;
+            bool correction;
+            double decay;     // 1 - alpha; 1 if not exponential
+            bool weighted;    // the metrics are weighted
+            std::size_t n;
+            double* output;
+        };
+
+        /**
+        * @brief The statistics of a window.
+        */
+        struct Window {
+            double count = 0.0;  // number of rows
+            CompensatedSum weight, weight_sq, bias, squared, absolute, relative, relative_ab, symmetric, logarithmic, huber;
+
+            double mean_a = 0.0;
+            double mean_p = 0.0;
+            double m2_a   = 0.0;  // sum(w * (a - mean_a)^2)
+            double m2_p   = 0.0;  // sum(w * (p - mean_p)^2)
+            double c_ap   = 0.0;  // sum(w * (a - mean_a) * (p - mean_p))
+
+            // add (sign = 1) or
+            // remove (sign = -1) row i
+            void update(const Context& context, std::size_t i, double sign) {
+                const double w { sign * (context.weights ? context.weights[i] : 1.0) };
+                const double a { context.actual[i] };
+                const double p { context.predicted[i] };
+                const double d { a - p };
+                const unsigned plan { context.plan };
+
+                // the empty window
+                // starts over
+                count += sign;
+                if (count <= 0.0) {
+                    *this = Window();
+                    return;
+                }
+
+                weight.add(w);
+                weight_sq.add(sign * w * w);
+
+                if (plan & RegressionMetrics::BIAS)     bias.add(w * d);
+                if (plan & RegressionMetrics::SQUARED)  squared.add(w * d * d);
+                if (plan & RegressionMetrics::ABSOLUTE) absolute.add(w * std::fabs(d));
+
+                if (plan & RegressionMetrics::RELATIVE) {
+                    relative.add(w * (d / a));
+                    relative_ab.add(w * (std::fabs(d) / a));
+                }
+
+                if (plan & RegressionMetrics::SYMMETRIC) {
+                    symmetric.add(w * (std::fabs(d) / ((std::fabs(a) + std::fabs(p)) / 2.0)));
+                }
+
+                if (plan & RegressionMetrics::LOGARITHMIC) {
+                    const double l { std::log(a + 1.0) - std::log(p + 1.0) };
+                    logarithmic.add(w * l * l);
+                }
+
+                if (plan & RegressionMetrics::HUBER_LOSS) {
+                    const double abs_d { std::fabs(d) };
+                    huber.add(w * (abs_d <= context.delta ? 0.5 * d * d : context.delta * (abs_d - 0.5 * context.delta)));
+                }
+
+                if (plan & (RegressionMetrics::ACTUAL | RegressionMetrics::PREDICTED)) {
+                    const double total { weight.value() };
+                    if (total == 0.0) {
+                        mean_a = mean_p = m2_a = m2_p = c_ap = 0.0;
+                        return;
+                    }
+
+                    const double da { a - mean_a };
+                    const double dp { p - mean_p };
+
+                    mean_a += w * da / total;
+                    mean_p += w * dp / total;
+                    m2_a   += w * da * (a - mean_a);
+                    m2_p   += w * dp * (p - mean_p);
+                    c_ap   += w * da * (p - mean_p);
+
+                    // a single row
+                    // has no spread
+                    if (count == 1.0) m2_a = m2_p = c_ap = 0.0;
+                }
+            }
+
+            // decay the weights
+            // of the window
+            void scale(double factor) {
+                if (factor == 1.0) return;
+
+                for (CompensatedSum* s : { &weight, &bias, &squared, &absolute, &relative, &relative_ab, &symmetric, &logarithmic, &huber }) {
+                    s->scale(factor);
+                }
+                weight_sq.scale(factor * factor);
+
+                m2_a *= factor;
+                m2_p *= factor;
+                c_ap *= factor;
+            }
+
+            // merge the window of
+            // the following rows
+            void merge(const Window& other) {
+                const double w_a { weight.value() };
+                const double w_b { other.weight.value() };
+                const double total { w_a + w_b };
+
+                if (total > 0.0 && w_b != 0.0) {
+                    const double delta_a { other.mean_a - mean_a };
+                    const double delta_p { other.mean_p - mean_p };
+                    const double factor  { w_a * w_b / total };
+
+                    mean_a += delta_a * w_b / total;
+                    mean_p += delta_p * w_b / total;
+                    m2_a   += other.m2_a + delta_a * delta_a * factor;
+                    m2_p   += other.m2_p + delta_p * delta_p * factor;
+                    c_ap   += other.c_ap + delta_a * delta_p * factor;
+                }
+
+                count += other.count;
+                weight.add(other.weight.sum);      weight.add(other.weight.compensation);
+                weight_sq.add(other.weight_sq.sum); weight_sq.add(other.weight_sq.compensation);
+
+                CompensatedSum* target[] { &bias, &squared, &absolute, &relative, &relative_ab, &symmetric, &logarithmic, &huber };
+                const CompensatedSum* source[] { &other.bias, &other.squared, &other.absolute, &other.relative, &other.relative_ab, &other.symmetric, &other.logarithmic, &other.huber };
+                for (std::size_t s = 0; s < 8; s++) {
+                    target[s]->add(source[s]->sum);
+                    target[s]->add(source[s]->compensation);
+                }
+            }
+
+            // the statistics
+            // of RegressionMetrics
+            RegressionStatistics statistics() const {
+                RegressionStatistics s;
+
+                s.n           = count;
+                s.weight      = weight.value();
+                s.weight_sq   = weight_sq.value();
+                s.bias        = bias.value();
+                s.squared     = squared.value();
+                s.absolute    = absolute.value();
+                s.relative    = relative.value();
+                s.relative_ab = relative_ab.value();
+                s.symmetric   = symmetric.value();
+                s.logarithmic = logarithmic.value();
+                s.huber       = huber.value();
+
+                s.moments.weight    = s.weight;
+                s.moments.weight_sq = s.weight_sq;
+                s.moments.mean_x    = mean_a;
+                s.moments.mean_y    = mean_p;
+                s.moments.m2_x      = m2_a;
+                s.moments.m2_y      = m2_p;
+                s.moments.c_xy      = c_ap;
+                s.moments.squared   = s.squared;
+
+                return s;
+            }
+        };
+
+        // write the metrics of
+        // the window into row i
+        static void write(const Context& context, const Window& window, std::size_t i)
+        {
+            const RegressionStatistics statistics { window.statistics() };
+
+            for (std::size_t m = 0; m < context.metrics.size(); m++) {
+                context.output[m * context.n + i] = RegressionMetrics::value(
+                    statistics, context.metrics[m], context.weighted, context.k, context.correction
+                );
+            }
+        }
+
+        /**
+        * @brief The sliding windows; the blocks are warmed up with the preceding rows.
+        */
+        static void sliding(const Context& context, std::size_t window)
+        {
+            const std::size_t n { context.n };
+            const std::size_t n_blocks { (n + window - 1) / window };
+
+            #ifdef _OPENMP
+                #pragma omp parallel for schedule(static) if(getUseOpenMP())
+            #endif
+            for (std::size_t b = 0; b < n_blocks; b++) {
+                const std::size_t first { b * window };
+                const std::size_t last  { std::min(n, first + window) };
+
+                // 1) warm up the window
+                //    with the preceding rows
+                Window state;
+                for (std::size_t i = first >= window ? first - window : 0; i < first; i++) {
+                    state.update(context, i, 1.0);
+                }
+
+                // 2) slide the window over the block;
+                //    the leaving row is removed first
+                for (std::size_t i = first; i < last; i++) {
+                    if (i >= window) state.update(context, i - window, -1.0);
+                    state.update(context, i, 1.0);
+
+                    if (i + 1 < window) {
+                        for (std::size_t m = 0; m < context.metrics.size(); m++) {
+                            context.output[m * n + i] = NA_REAL;
+                        }
+                        continue;
+                    }
+
+                    write(context, state, i);
+                }
+            }
+        }
+
+        /**
+        * @brief The expanding and exponential windows; a parallel scan over the blocks.
+        */
+        static void scan(const Context& context)
+        {
+            const std::size_t n { context.n };
+            const std::size_t n_blocks { (n + block_size - 1) / block_size };
+            if (n_blocks == 0) return;
+
+            // accumulate the rows [first, last)
+            // into state; write if output
+            auto run = [&context](Window& state, std::size_t first, std::size_t last, bool output) {
+                for (std::size_t i = first; i < last; i++) {
+                    state.scale(context.decay);
+                    state.update(context, i, 1.0);
+                    if (output) write(context, state, i);
+                }
+            };
+
+            // 1) the window of each block
+            //    alone; the last is not carried
+            std::vector<Window> blocks(n_blocks);
+
+            #ifdef _OPENMP
+                #pragma omp parallel for schedule(static) if(getUseOpenMP() && n_blocks > 1)
+            #endif
+            for (std::size_t b = 0; b < n_blocks - 1; b++) {
+                run(blocks[b], b * block_size, std::min(n, (b + 1) * block_size), false);
+            }
+
+            // 2) the window carried into
+            //    each block; the preceding
+            //    rows decay over the block
+            std::vector<Window> carried(n_blocks);
+            for (std::size_t b = 1; b < n_blocks; b++) {
+                carried[b] = carried[b - 1];
+                carried[b].scale(std::pow(context.decay, static_cast<double>(block_size)));
+                carried[b].merge(blocks[b - 1]);
+            }
+
+            // 3) each block from the
+            //    window carried into it
+            #ifdef _OPENMP
+                #pragma omp parallel for schedule(static) if(getUseOpenMP() && n_blocks > 1)
+            #endif
+            for (std::size_t b = 0; b < n_blocks; b++) {
+                run(carried[b], b * block_size, std::min(n, (b + 1) * block_size), true);
+            }
+        }
+
+        // map the name
+        // to the window
+        static int window_method(const std::string& name)
+        {
+            if (name == "sliding")     return SLIDING;
+            if (name == "expanding")   return EXPANDING;
+            if (name == "exponential") return EXPONENTIAL;
+
+            Rcpp::stop("`type` must be one of \"sliding\", \"expanding\" and \"exponential\".");
+        }
+
+        // Prevents the compiler from doing
+        // bad stuff.
+        RollingMetrics()  = delete;
+        ~RollingMetrics() = delete;
+};
+
+#endif
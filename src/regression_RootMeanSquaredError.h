@@ -2,6 +2,7 @@
 #define REGRESSION_ROOTMEANSQUAREDEROR_H
 
 #include "utilities_Package.h"
+#include "utilities_SIMD.h"
 #include <cmath>
 #include <cstddef>
 
@@ -14,39 +15,20 @@ class RMSE {
         // Unweighted RMSE
         static double compute(const double* actual, const double* predicted, std::size_t n)
         {
-            double squared_sum = 0.0;
-
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:squared_sum) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double difference = actual[i] - predicted[i];
-                squared_sum += difference * difference;
-            }
-
-            double mse = squared_sum / static_cast<double>(n);
+            double weight = 0.0;
+            double squared_sum = SIMD::reduce(SIMD::kernels().squared, actual, predicted, nullptr, n, 0.0, weight);
 
+            double mse = squared_sum / weight;
             return std::sqrt(mse);
         }
 
         // Weighted RMSE
         static double compute(const double* actual, const double* predicted, const double* weights, std::size_t n)
         {
-            double squared_sum = 0.0;
-            double weighted_sum  = 0.0;
-
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:squared_sum, weighted_sum) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double difference = actual[i] - predicted[i];
-                double w    = weights[i];
-                squared_sum += w * difference * difference;
-                weighted_sum  += w;
-            }
+            double weighted_sum = 0.0;
+            double squared_sum  = SIMD::reduce(SIMD::kernels().squared, actual, predicted, weights, n, 0.0, weighted_sum);
 
             double mse = squared_sum / weighted_sum;
-            
             return std::sqrt(mse);
         }
 
@@ -2,6 +2,7 @@
 #define REGRESSION_ROOTRELATIVESQUAREERROR_H
 
 #include "utilities_Package.h"
+#include "utilities_Moments.h"
 #include <cmath>
 #include <cstddef>
 
@@ -22,27 +23,12 @@ class RRSE {
         */
         static double compute(const double* actual, const double* predicted, std::size_t n)
         {
-            // 1) Calculate mean of 'actual'
-            double sum_actual = 0.0;
-            for (std::size_t i = 0; i < n; ++i) {
-                sum_actual += actual[i];
-            }
-            double mean_actual = sum_actual / static_cast<double>(n);
+            // 1) Calculate numerator and denominator
+            //    in one parallel pass
+            const Moments moments = Moments::compute(actual, predicted, nullptr, n);
 
-            // 2) Calculate numerator and denominator
-            double numerator   = 0.0;
-            double denominator = 0.0;
-
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:numerator, denominator) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double diff_pred = actual[i] - predicted[i];
-                double diff_mean = actual[i] - mean_actual;
-
-                numerator   += diff_pred * diff_pred;
-                denominator += diff_mean * diff_mean;
-            }
+            double numerator   = moments.squared;
+            double denominator = moments.m2_x;
 
             // No check for zero denominator, as requested
             return std::sqrt(numerator / denominator);
@@ -60,32 +46,14 @@ class RRSE {
         */
         static double compute(const double* actual, const double* predicted, const double* weights, std::size_t n)
         {
-            // 1) Calculate weighted mean of 'actual'
-            double weighted_sum = 0.0;
-            double weight_sum   = 0.0;
-            for (std::size_t i = 0; i < n; ++i) {
-                weighted_sum += weights[i] * actual[i];
-                weight_sum   += weights[i];
-            }
-            double mean_w_actual = weighted_sum / weight_sum;
-
-            // 2) Calculate numerator and denominator
-            double numerator   = 0.0;
-            double denominator = 0.0;
-
-            #ifdef _OPENMP
-                #pragma omp parallel for reduction(+:numerator, denominator) if(getUseOpenMP())
-            #endif
-            for (std::size_t i = 0; i < n; ++i) {
-                double w         = weights[i];
-                double diff_pred = actual[i] - predicted[i];
-                double diff_mean = actual[i] - mean_w_actual;
+            // 1) Calculate numerator and denominator
+            //    in one parallel pass
+            const Moments moments = Moments::compute(actual, predicted, weights, n);
 
-                numerator   += w * (diff_pred * diff_pred);
-                denominator += w * (diff_mean * diff_mean);
-            }
+            double numerator   = moments.squared;
+            double denominator = moments.m2_x;
 
-            // 3) Return RRSE
+            // 2) Return RRSE
             return std::sqrt(numerator / denominator);
         }
 
@@ -1,119 +1,106 @@
 // [[Rcpp::plugins(cpp23)]]
 #include <Rcpp.h>
-#include <algorithm>
-#include <functional>
-
-#ifdef PARALLEL
-    #include <execution>
-        namespace execution = std::execution;
-#else
-    enum class execution { seq, unseq, par_unseq, par };
-#endif
+#include "utilities_Sorting.h"
+#include "utilities_Ranking.h"
 
 /**
  * @brief This function assumes that the matrix columns
  * are independent, and sorts each column independently of
- * of eachother
+ * of eachother. The columns are sorted into `out` if passed,
+ * and into a new matrix otherwise; `x` is never modified.
  */
 //' @method presort matrix
 //' @export
 // [[Rcpp::export(presort.matrix)]]
 Rcpp::NumericMatrix sort_matrix(
-  Rcpp::NumericMatrix x, 
-  bool decreasing = false) {
-
-    // 0) extract matrix
-    // dimensions for the
-    // sorting    
-    const int n_rows = x.nrow();
-    const int n_cols = x.ncol();
-    
-    // 1) extract pointer
-    // to matrix and loop
-    double* data = x.begin();
-    #ifdef PARALLEL
-        if (decreasing) {
-            for (int col = 0; col < n_cols; ++col) {
-                double* col_begin = data + col * n_rows;
-                double* col_end   = col_begin + n_rows;
-
-                std::sort(execution::par_unseq, col_begin, col_end, std::greater<>());
-            }
-        } else {
-            for (int col = 0; col < n_cols; ++col) {
-                double* col_begin = data + col * n_rows;
-                double* col_end   = col_begin + n_rows;
+  const Rcpp::NumericMatrix& x, 
+  bool decreasing = false,
+  Rcpp::Nullable<Rcpp::NumericMatrix> out = R_NilValue) {
 
-                std::sort(execution::par_unseq, col_begin, col_end);
-            }
-        }
-    #else
-        if (decreasing) {
-            for (int col = 0; col < n_cols; ++col) {
-                double* col_begin = data + col * n_rows;
-                double* col_end   = col_begin + n_rows;
+    // 0) the output; either the
+    // buffer passed by the caller,
+    // or a new matrix. The buffer is
+    // never coerced, as the columns
+    // would be sorted into a copy
+    if (out.isNotNull() && TYPEOF(out.get()) != REALSXP) {
+        Rcpp::stop("`out` must be a <double> matrix.");
+    }
 
-                std::sort(col_begin, col_end, std::greater<>());
-            }
-        } else {
-            for (int col = 0; col < n_cols; ++col) {
-                double* col_begin = data + col * n_rows;
-                double* col_end   = col_begin + n_rows;
+    Rcpp::NumericMatrix output { out.isNotNull() ? Rcpp::as<Rcpp::NumericMatrix>(out) : Rcpp::NumericMatrix(x.nrow(), x.ncol()) };
+    if (output.nrow() != x.nrow() || output.ncol() != x.ncol()) {
+        Rcpp::stop("The dimensions of `out` does not match `x`.");
+    }
 
-                std::sort(col_begin, col_end);
-            }
-        }
-    #endif
+    // 1) sort the columns
+    // in parallel
+    ColumnSort::sort(x.begin(), output.begin(), x.nrow(), x.ncol(), decreasing);
 
-    return x;
+    return output;
 }
 
+/**
+ * @brief This function assumes that the matrix columns
+ * are independent, and orders each column independently of
+ * of eachother; the (1-based) indices are written into `out`
+ * if passed, and into a new matrix otherwise.
+ */
 //' @method preorder matrix
 //' @export
 // [[Rcpp::export(preorder.matrix)]]
 Rcpp::IntegerMatrix order_matrix(
-    Rcpp::NumericMatrix x, 
-    bool decreasing = false) {
+    const Rcpp::NumericMatrix& x, 
+    bool decreasing = false,
+    Rcpp::Nullable<Rcpp::IntegerMatrix> out = R_NilValue) {
 
-        const int n_rows = x.nrow();
-        const int n_cols = x.ncol();
-        Rcpp::IntegerMatrix index_matrix(n_rows, n_cols);
-        std::vector<int> indices(n_rows);
-        std::iota(indices.begin(), indices.end(), 0);
+        // 0) the output; either the
+        // buffer passed by the caller,
+        // or a new matrix. The buffer is
+        // never coerced, as the indices
+        // would be written into a copy
+        if (out.isNotNull() && TYPEOF(out.get()) != INTSXP) {
+            Rcpp::stop("`out` must be an <integer> matrix.");
+        }
 
-        // std::ranges::iota(indices, 0);
+        Rcpp::IntegerMatrix output { out.isNotNull() ? Rcpp::as<Rcpp::IntegerMatrix>(out) : Rcpp::IntegerMatrix(x.nrow(), x.ncol()) };
+        if (output.nrow() != x.nrow() || output.ncol() != x.ncol()) {
+            Rcpp::stop("The dimensions of `out` does not match `x`.");
+        }
 
-        for (int col = 0; col < n_cols; ++col) {
-            #ifdef PARALLEL
-              if (decreasing) {
-                  std::sort(execution::par_unseq, indices.begin(), indices.end(),
-                          [&x, col](int i, int j) {
-                              return x(i, col) > x(j, col);
-                          });
-              } else {
-                  std::sort(execution::par_unseq, indices.begin(), indices.end(),
-                          [&x, col](int i, int j) {
-                              return x(i, col) < x(j, col);
-                          });
-              }
-            #else
-              if (decreasing) {
-                  std::sort(indices.begin(), indices.end(),
-                          [&x, col](int i, int j) {
-                              return x(i, col) > x(j, col);
-                          });
-              } else {
-                  std::sort(indices.begin(), indices.end(),
-                          [&x, col](int i, int j) {
-                              return x(i, col) < x(j, col);
-                          });
-              }
-            #endif
+        // 1) order the columns
+        // in parallel
+        ColumnSort::order(x.begin(), output.begin(), x.nrow(), x.ncol(), decreasing, 1);
+        
+        return output;
+}
 
-            for (int row = 0; row < n_rows; ++row) {
-                index_matrix(row, col) = indices[row] + 1;
-            }
+/**
+ * @brief This function ranks each column in descending
+ * order once, so the ranking can be passed to all ROC, 
+ * precision-recall and AUC functions
+ */
+//' @method ranking matrix
+//' @export
+// [[Rcpp::export(ranking.matrix)]]
+Rcpp::List ranking_matrix(
+    const Rcpp::NumericMatrix& response,
+    Rcpp::Nullable<Rcpp::IntegerVector> actual = R_NilValue,
+    Rcpp::Nullable<Rcpp::NumericVector> w = R_NilValue) {
+
+        if (actual.isNotNull() && w.isNotNull()) {
+            Rcpp::IntegerVector a = Rcpp::as<Rcpp::IntegerVector>(actual);
+            Rcpp::NumericVector wt = Rcpp::as<Rcpp::NumericVector>(w);
+            return Ranking::create(response, &a, &wt);
         }
-        
-        return index_matrix;
-}
\ No newline at end of file
+
+        if (actual.isNotNull()) {
+            Rcpp::IntegerVector a = Rcpp::as<Rcpp::IntegerVector>(actual);
+            return Ranking::create(response, &a, nullptr);
+        }
+
+        if (w.isNotNull()) {
+            Rcpp::NumericVector wt = Rcpp::as<Rcpp::NumericVector>(w);
+            return Ranking::create(response, nullptr, &wt);
+        }
+
+        return Ranking::create(response);
+}
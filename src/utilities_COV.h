@@ -2,6 +2,7 @@
 #define utilities_COV_hpp
 
 #include "utilities_Package.h" 
+#include "utilities_Moments.h"
 #include <cmath>          
 
 
@@ -76,69 +77,27 @@ inline CovarianceResult<int> CovarianceCalculator::cov(
     bool center,
     bool unbiased) {
 
-
         CovarianceResult<int> res;
         res.n = n;
 
+        // 1) the moments in one
+        //    parallel pass
+        const Moments moments = Moments::compute(x, y, nullptr, static_cast<std::size_t>(n));
 
-        double xSum = 0.0, ySum = 0.0;
-        if (center) {
-        #ifdef _OPENMP
-                if (getUseOpenMP()) {
-                    #pragma omp parallel for reduction(+:xSum,ySum)
-                    for (int i = 0; i < n; ++i) {
-                        xSum += x[i];
-                        ySum += y[i];
-                    }
-                } else
-        #endif
-                {
-                    // Non-parallel fallback
-                    for (int i = 0; i < n; ++i) {
-                        xSum += x[i];
-                        ySum += y[i];
-                    }
-                }
-
-                res.xCenter = xSum / static_cast<double>(n);
-                res.yCenter = ySum / static_cast<double>(n);
-            } else {
-                res.xCenter = 0.0;
-                res.yCenter = 0.0;
-            }
+        // 2) the (un)centered sums
+        //    of squares and products
+        double sxx = moments.m2_x, syy = moments.m2_y, sxy = moments.c_xy;
 
-            double sxx = 0.0, syy = 0.0, sxy = 0.0;
+        if (center) {
+            res.xCenter = moments.mean_x;
+            res.yCenter = moments.mean_y;
+        } else {
+            res.xCenter = 0.0;
+            res.yCenter = 0.0;
 
-        #ifdef _OPENMP
-        if (getUseOpenMP()) {
-            #pragma omp parallel
-            {
-                double sxxLocal = 0.0, syyLocal = 0.0, sxyLocal = 0.0;
-                #pragma omp for
-                for (int i = 0; i < n; ++i) {
-                    double xAdj = x[i] - res.xCenter;
-                    double yAdj = y[i] - res.yCenter;
-                    sxxLocal += xAdj * xAdj;
-                    syyLocal += yAdj * yAdj;
-                    sxyLocal += xAdj * yAdj;
-                }
-                #pragma omp critical
-                {
-                    sxx += sxxLocal;
-                    syy += syyLocal;
-                    sxy += sxyLocal;
-                }
-            }
-        } else
-        #endif
-        {
-            for (int i = 0; i < n; ++i) {
-                double xAdj = x[i] - res.xCenter;
-                double yAdj = y[i] - res.yCenter;
-                sxx += xAdj * xAdj;
-                syy += yAdj * yAdj;
-                sxy += xAdj * yAdj;
-            }
+            sxx += moments.weight * moments.mean_x * moments.mean_x;
+            syy += moments.weight * moments.mean_y * moments.mean_y;
+            sxy += moments.weight * moments.mean_x * moments.mean_y;
         }
 
         // 3) Denominator
@@ -160,108 +119,35 @@ inline CovarianceResult<double> CovarianceCalculator::cov(
     bool unbiased) {
         CovarianceResult<double> res;
 
-        double wSum = 0.0;
-        double xAcc = 0.0, yAcc = 0.0;
+        // 1) the weighted moments
+        //    in one parallel pass
+        const Moments moments = Moments::compute(x, y, w, static_cast<std::size_t>(n));
+        const double wSum = moments.weight;
 
-        #ifdef _OPENMP
-        if (getUseOpenMP()) {
-            #pragma omp parallel
-            {
-                double wSumLocal = 0.0;
-                double xAccLocal = 0.0;
-                double yAccLocal = 0.0;
-
-                #pragma omp for
-                for (int i = 0; i < n; ++i) {
-                    wSumLocal += w[i];
-                    xAccLocal += w[i] * x[i];
-                    yAccLocal += w[i] * y[i];
-                }
-                #pragma omp critical
-                {
-                    wSum += wSumLocal;
-                    xAcc += xAccLocal;
-                    yAcc += yAccLocal;
-                }
-            }
-        } else
-        #endif
-        {
-            for (int i = 0; i < n; ++i) {
-                wSum     += w[i];
-                xAcc     += w[i] * x[i];
-                yAcc     += w[i] * y[i];
-            }
-        }
+        // 2) the (un)centered sums of squares and
+        //    products with the normalized weights w / wSum
+        double sxx = moments.m2_x, syy = moments.m2_y, sxy = moments.c_xy;
 
         if (center && wSum > 0.0) {
-            res.xCenter = xAcc / wSum;
-            res.yCenter = yAcc / wSum;
+            res.xCenter = moments.mean_x;
+            res.yCenter = moments.mean_y;
         } else {
             res.xCenter = 0.0;
             res.yCenter = 0.0;
-        }
-
-        double sxx = 0.0, syy = 0.0, sxy = 0.0;
-
-        #ifdef _OPENMP
-        if (getUseOpenMP()) {
-            #pragma omp parallel
-            {
-                double sxxLocal = 0.0, syyLocal = 0.0, sxyLocal = 0.0;
-                #pragma omp for
-                for (int i = 0; i < n; ++i) {
-
-                    double wNorm = w[i] / wSum;
-                    double xAdj  = x[i] - res.xCenter;
-                    double yAdj  = y[i] - res.yCenter;
 
-                    sxxLocal += wNorm * xAdj * xAdj;
-                    syyLocal += wNorm * yAdj * yAdj;
-                    sxyLocal += wNorm * xAdj * yAdj;
-                }
-                #pragma omp critical
-                {
-                    sxx += sxxLocal;
-                    syy += syyLocal;
-                    sxy += sxyLocal;
-                }
-            }
-        } else
-        #endif
-        {
-            for (int i = 0; i < n; ++i) {
-                double wNorm = w[i] / wSum;
-                double xAdj  = x[i] - res.xCenter;
-                double yAdj  = y[i] - res.yCenter;
-
-                sxx += wNorm * xAdj * xAdj;
-                syy += wNorm * yAdj * yAdj;
-                sxy += wNorm * xAdj * yAdj;
-            }
+            sxx += wSum * moments.mean_x * moments.mean_x;
+            syy += wSum * moments.mean_y * moments.mean_y;
+            sxy += wSum * moments.mean_x * moments.mean_y;
         }
 
+        sxx /= wSum;
+        syy /= wSum;
+        sxy /= wSum;
+
         // 3) Unbiased correction
         if (unbiased) {
             // sum of squares of (wNorm)
-            double sumNormW2 = 0.0;
-        #ifdef _OPENMP
-            if (getUseOpenMP()) {
-                double localNorm = 0.0;
-                #pragma omp parallel for reduction(+:localNorm)
-                for (int i = 0; i < n; ++i) {
-                    double wNorm = w[i] / wSum;
-                    localNorm += wNorm * wNorm;
-                }
-                sumNormW2 = localNorm;
-            } else
-        #endif
-            {
-                for (int i = 0; i < n; ++i) {
-                    double wNorm = w[i] / wSum;
-                    sumNormW2 += wNorm * wNorm;
-                }
-            }
+            double sumNormW2 = moments.weight_sq / (wSum * wSum);
             double denom = 1.0 - sumNormW2;
             if (denom > 0.0) {
                 sxx /= denom;
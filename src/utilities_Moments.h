@@ -0,0 +1,173 @@
+#ifndef UTILITIES_MOMENTS_H
+#define UTILITIES_MOMENTS_H
+
+#include "utilities_Package.h"
+#include <algorithm>
+#include <cstddef>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @struct Moments
+ * @brief Mergeable (weighted) first and second moments of x and y.
+ *
+ * The moments of a block of rows are computed with two passes over the
+ * block, which is in cache, and the blocks are merged with the update of
+ * Chan, Golub and LeVeque:
+ *
+ *   delta  = mean_b - mean_a
+ *   mean   = mean_a + delta * W_b / W
+ *   M2     = M2_a + M2_b + delta^2 * W_a * W_b / W
+ *   C_xy   = C_a + C_b + delta_x * delta_y * W_a * W_b / W
+ *
+ * so the moments are computed in one parallel pass over the rows without
+ * the cancellation of the raw sums of squares. The sum of squared
+ * differences, sum(w * (x - y)^2), is carried along for R^2 and RRSE.
+ */
+struct Moments {
+    double weight    = 0.0;  // sum(w)
+    double weight_sq = 0.0;  // sum(w^2)
+    double mean_x    = 0.0;
+    double mean_y    = 0.0;
+    double m2_x      = 0.0;  // sum(w * (x - mean_x)^2)
+    double m2_y      = 0.0;  // sum(w * (y - mean_y)^2)
+    double c_xy      = 0.0;  // sum(w * (x - mean_x) * (y - mean_y))
+    double squared   = 0.0;  // sum(w * (x - y)^2)
+
+    // merge the moments
+    // of another block
+    void merge(const Moments& other) {
+        if (other.weight == 0.0) return;
+        if (weight == 0.0) {
+            *this = other;
+            return;
+        }
+
+        const double total   { weight + other.weight };
+        const double delta_x { other.mean_x - mean_x };
+        const double delta_y { other.mean_y - mean_y };
+        const double scale   { weight * other.weight / total };
+
+        mean_x    += delta_x * other.weight / total;
+        mean_y    += delta_y * other.weight / total;
+        m2_x      += other.m2_x + delta_x * delta_x * scale;
+        m2_y      += other.m2_y + delta_y * delta_y * scale;
+        c_xy      += other.c_xy + delta_x * delta_y * scale;
+        squared   += other.squared;
+        weight     = total;
+        weight_sq += other.weight_sq;
+    }
+
+    /**
+    * Compute the moments of a block of rows.
+    *
+    * @param x Pointer to x.
+    * @param y Pointer to y; nullptr for the moments of x alone.
+    * @param w Pointer to the weights; nullptr if unweighted.
+    * @param n Number of rows.
+    */
+    static Moments block(const double* x, const double* y, const double* w, std::size_t n) {
+        if (w) {
+            return y ? block<true, true>(x, y, w, n) : block<true, false>(x, y, w, n);
+        }
+
+        return y ? block<false, true>(x, y, w, n) : block<false, false>(x, y, w, n);
+    }
+
+    /**
+    * Compute the moments of all rows in one parallel pass.
+    *
+    * @param x Pointer to x.
+    * @param y Pointer to y; nullptr for the moments of x alone.
+    * @param w Pointer to the weights; nullptr if unweighted.
+    * @param n Number of rows.
+    */
+    static Moments compute(const double* x, const double* y, const double* w, std::size_t n) {
+        const std::size_t n_blocks { (n + block_size - 1) / block_size };
+
+        Moments moments;
+
+        #ifdef _OPENMP
+            #pragma omp parallel if(getUseOpenMP())
+        #endif
+        {
+            Moments local;
+
+            #ifdef _OPENMP
+                #pragma omp for schedule(static)
+            #endif
+            for (std::size_t b = 0; b < n_blocks; b++) {
+                const std::size_t first { b * block_size };
+                const std::size_t last  { std::min(n, first + block_size) };
+
+                local.merge(block(x + first, y ? y + first : nullptr, w ? w + first : nullptr, last - first));
+            }
+
+            #ifdef _OPENMP
+                #pragma omp critical
+            #endif
+            {
+                moments.merge(local);
+            }
+        }
+
+        return moments;
+    }
+
+    private:
+        // rows per block
+        static constexpr std::size_t block_size = 4096;
+
+        template <bool weighted, bool bivariate>
+        static Moments block(const double* x, const double* y, const double* w, std::size_t n) {
+            Moments moments;
+
+            // 1) the means
+            double sum_w = 0.0, sum_w_sq = 0.0, sum_x = 0.0, sum_y = 0.0;
+            for (std::size_t i = 0; i < n; i++) {
+                const double weight { weighted ? w[i] : 1.0 };
+
+                sum_w    += weight;
+                sum_w_sq += weight * weight;
+                sum_x    += weight * x[i];
+                if constexpr (bivariate) sum_y += weight * y[i];
+            }
+
+            if (sum_w == 0.0) return moments;
+
+            moments.weight    = sum_w;
+            moments.weight_sq = sum_w_sq;
+            moments.mean_x    = sum_x / sum_w;
+            moments.mean_y    = sum_y / sum_w;
+
+            // 2) the centered
+            //    second moments
+            double m2_x = 0.0, m2_y = 0.0, c_xy = 0.0, squared = 0.0;
+            for (std::size_t i = 0; i < n; i++) {
+                const double weight { weighted ? w[i] : 1.0 };
+                const double dx { x[i] - moments.mean_x };
+
+                m2_x += weight * dx * dx;
+
+                if constexpr (bivariate) {
+                    const double dy { y[i] - moments.mean_y };
+                    const double d  { x[i] - y[i] };
+
+                    m2_y    += weight * dy * dy;
+                    c_xy    += weight * dx * dy;
+                    squared += weight * d * d;
+                }
+            }
+
+            moments.m2_x    = m2_x;
+            moments.m2_y    = m2_y;
+            moments.c_xy    = c_xy;
+            moments.squared = squared;
+
+            return moments;
+        }
+};
+
+#endif
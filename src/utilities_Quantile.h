@@ -0,0 +1,560 @@
+#ifndef UTILITIES_QUANTILE_H
+#define UTILITIES_QUANTILE_H
+
+#include "utilities_Package.h"
+#include <algorithm>
+#include <cmath>
+#include <cstddef>
+#include <cstdio>
+#include <limits>
+#include <random>
+#include <string>
+#include <vector>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @class Quantile
+ * @brief Quantiles by selection instead of sorting.
+ *
+ * The unweighted quantile interpolates between the order statistics
+ * around alpha * (n - 1) (type 7 in R), and the weighted quantile is the
+ * smallest value whose cumulative weight reaches alpha * sum(w).
+ *
+ * Small inputs are copied once and the order statistics are selected
+ * in expected O(n). Large inputs are not copied: each quantile is
+ * bracketed by two pivots drawn from a sample of the values, and one
+ * parallel pass counts the values between the brackets and collects
+ * the few values inside them, where the quantiles are then selected.
+ * If a quantile falls outside its bracket, which is unlikely, the
+ * quantiles are selected from a full copy.
+ *
+ * The values (and weights) are read through accessors, value(i) and
+ * weight(i), so the quantiles of derived values, for example the
+ * absolute errors, are computed without storing them.
+ */
+class Quantile {
+    public:
+        struct Observation {
+            double value;
+            double weight;
+        };
+
+        /**
+        * The unweighted quantile of x.
+        *
+        * @param x     Pointer to the values.
+        * @param n     Number of values.
+        * @param alpha The quantile level in [0, 1].
+        */
+        static double compute(const double* x, std::size_t n, double alpha)
+        {
+            return compute([x](std::size_t i) { return x[i]; }, n, alpha);
+        }
+
+        /**
+        * The weighted quantile of x.
+        *
+        * @param x     Pointer to the values.
+        * @param w     Pointer to the weights.
+        * @param n     Number of values.
+        * @param alpha The quantile level in [0, 1].
+        */
+        static double compute(const double* x, const double* w, std::size_t n, double alpha)
+        {
+            return compute([x](std::size_t i) { return x[i]; }, [w](std::size_t i) { return w[i]; }, n, alpha);
+        }
+
+        /**
+        * The unweighted quantile of value(0), ..., value(n - 1).
+        */
+        template <typename Value>
+        static double compute(Value value, std::size_t n, double alpha)
+        {
+            return compute(value, n, std::vector<double> { alpha })[0];
+        }
+
+        /**
+        * The weighted quantile of value(0), ..., value(n - 1)
+        * with the weights weight(0), ..., weight(n - 1).
+        */
+        template <typename Value, typename Weight>
+        static double compute(Value value, Weight weight, std::size_t n, double alpha)
+        {
+            return compute(value, weight, n, std::vector<double> { alpha })[0];
+        }
+
+        /**
+        * The unweighted quantiles of value(0), ..., value(n - 1) at
+        * each level of `alpha`; all levels are selected from one
+        * pass over the values.
+        */
+        template <typename Value>
+        static std::vector<double> compute(Value value, std::size_t n, const std::vector<double>& alpha)
+        {
+            // 1) the order statistics
+            //    around alpha * (n - 1)
+            std::vector<std::size_t> ranks;
+            for (double a : alpha) {
+                const std::size_t lower { static_cast<std::size_t>(a * static_cast<double>(n - 1)) };
+                ranks.push_back(lower);
+                ranks.push_back(std::min(lower + 1, n - 1));
+            }
+            std::sort(ranks.begin(), ranks.end());
+            ranks.erase(std::unique(ranks.begin(), ranks.end()), ranks.end());
+
+            // 2) the segments of values that hold
+            //    the order statistics
+            std::vector<Segment<double>> segments;
+            if (n < threshold || !bracket(value, n, ranks, segments)) {
+                segments.assign(1, Segment<double> {});
+                segments[0].values.resize(n);
+
+                #ifdef _OPENMP
+                    #pragma omp parallel for schedule(static) if(getUseOpenMP())
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    segments[0].values[i] = value(i);
+                }
+            }
+
+            // 3) select the order statistics in
+            //    ascending order; each selection
+            //    continues after the previous
+            std::vector<double> selected(ranks.size());
+            std::size_t r = 0;
+            for (Segment<double>& segment : segments) {
+                auto first { segment.values.begin() };
+
+                for (; r < ranks.size() && ranks[r] < segment.count_below + segment.values.size(); r++) {
+                    const auto nth { segment.values.begin() + (ranks[r] - segment.count_below) };
+                    std::nth_element(first, nth, segment.values.end());
+
+                    selected[r] = *nth;
+                    first       = nth + 1;
+                }
+            }
+
+            // 4) interpolate between
+            //    the order statistics
+            std::vector<double> output;
+            output.reserve(alpha.size());
+            for (double a : alpha) {
+                const double position   { a * static_cast<double>(n - 1) };
+                const std::size_t lower { static_cast<std::size_t>(position) };
+                const std::size_t upper { std::min(lower + 1, n - 1) };
+
+                const double lower_value { selected[std::lower_bound(ranks.begin(), ranks.end(), lower) - ranks.begin()] };
+                const double upper_value { selected[std::lower_bound(ranks.begin(), ranks.end(), upper) - ranks.begin()] };
+
+                output.push_back(lower_value + (upper_value - lower_value) * (position - static_cast<double>(lower)));
+            }
+
+            return output;
+        }
+
+        /**
+        * The weighted quantiles of value(0), ..., value(n - 1) with
+        * the weights weight(0), ..., weight(n - 1) at each level of
+        * `alpha`; all levels are selected from one pass over the values.
+        */
+        template <typename Value, typename Weight>
+        static std::vector<double> compute(Value value, Weight weight, std::size_t n, const std::vector<double>& alpha)
+        {
+            // 1) the segments of observations
+            //    that hold the quantiles
+            std::vector<Segment<Observation>> segments;
+            double total = 0.0;
+
+            if (n < threshold || !bracket(value, weight, n, alpha, segments, total)) {
+                segments.assign(1, Segment<Observation> {});
+                segments[0].values.resize(n);
+                total = 0.0;
+
+                #ifdef _OPENMP
+                    #pragma omp parallel for reduction(+:total) schedule(static) if(getUseOpenMP())
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    segments[0].values[i] = Observation { value(i), weight(i) };
+                    total += segments[0].values[i].weight;
+                }
+
+                segments[0].weight_inside = total;
+            }
+
+            // 2) select each quantile within
+            //    the segment that holds it
+            std::vector<double> output;
+            output.reserve(alpha.size());
+            for (double a : alpha) {
+                Segment<Observation>& segment { segments[locate(segments, n, a * total)] };
+                Observation* first { segment.values.data() };
+
+                output.push_back(select(first, first + segment.values.size(), a * total - segment.weight_below));
+            }
+
+            return output;
+        }
+
+        /**
+        * The names of the quantile levels in
+        * percent, eg. "2.5%" and "97.5%".
+        *
+        * @param alpha The quantile levels.
+        */
+        static Rcpp::CharacterVector labels(const std::vector<double>& alpha)
+        {
+            Rcpp::CharacterVector names(alpha.size());
+            for (std::size_t j = 0; j < alpha.size(); j++) {
+                char label[32];
+                std::snprintf(label, sizeof(label), "%.7g%%", 100.0 * alpha[j]);
+                names[j] = std::string(label);
+            }
+
+            return names;
+        }
+
+    private:
+        // rows from which the quantiles
+        // are bracketed by a sample
+        static constexpr std::size_t threshold = 1 << 20;
+
+        // the size of the sample
+        static constexpr std::size_t sample_size = 1 << 16;
+
+        /**
+        * @brief The values between two pivots,
+        * and the rows and the weight below them.
+        */
+        template <typename T>
+        struct Segment {
+            std::vector<T> values;
+            std::size_t count_below = 0;
+            double weight_below     = 0.0;
+            double weight_inside    = 0.0;
+        };
+
+        /**
+        * The smallest value whose cumulative weight reaches
+        * `target`, by weighted quickselect on [first, last).
+        */
+        static double select(Observation* first, Observation* last, double target)
+        {
+            while (last - first > 16) {
+                // 1) the median of three
+                //    as the pivot
+                double a { first->value }, b { first[(last - first) / 2].value }, c { (last - 1)->value };
+                if (a > b) std::swap(a, b);
+                if (b > c) std::swap(b, c);
+                if (a > b) std::swap(a, b);
+                const double pivot { b };
+
+                // 2) partition into the values below,
+                //    equal to and above the pivot
+                Observation* middle { std::partition(first, last, [pivot](const Observation& o) { return o.value < pivot; }) };
+                Observation* upper  { std::partition(middle, last, [pivot](const Observation& o) { return !(pivot < o.value); }) };
+
+                double below = 0.0, equal = 0.0;
+                for (Observation* o = first; o != middle; ++o) below += o->weight;
+                for (Observation* o = middle; o != upper; ++o) equal += o->weight;
+
+                // 3) continue in the part
+                //    that reaches the target
+                if (middle != first && target <= below) {
+                    last = middle;
+                    continue;
+                }
+
+                if (target <= below + equal || upper == last) {
+                    return pivot;
+                }
+
+                target -= below + equal;
+                first   = upper;
+            }
+
+            std::sort(first, last, [](const Observation& x, const Observation& y) { return x.value < y.value; });
+
+            double cumulative = 0.0;
+            for (Observation* o = first; o != last; ++o) {
+                cumulative += o->weight;
+                if (cumulative >= target) return o->value;
+            }
+
+            return (last - 1)->value;
+        }
+
+        // the segment that holds the weighted quantile;
+        // the weight below it does not reach the target
+        // and the weight up to its end does
+        static std::size_t locate(const std::vector<Segment<Observation>>& segments, std::size_t n, double target)
+        {
+            for (std::size_t j = 0; j < segments.size(); j++) {
+                const Segment<Observation>& segment { segments[j] };
+                const bool above { segment.count_below + segment.values.size() < n };
+
+                if (!segment.values.empty()
+                    && (segment.count_below == 0 || segment.weight_below < target)
+                    && (!above || target <= segment.weight_below + segment.weight_inside)) {
+                    return j;
+                }
+            }
+
+            return segments.size();
+        }
+
+        // the rows of the sample; drawn with
+        // a fixed seed so the pivots are
+        // reproducible
+        static std::vector<std::size_t> draw(std::size_t n)
+        {
+            std::mt19937_64 generator(n);
+            std::uniform_int_distribution<std::size_t> row(0, n - 1);
+
+            std::vector<std::size_t> rows(sample_size);
+            for (std::size_t& i : rows) i = row(generator);
+
+            return rows;
+        }
+
+        /**
+        * Merge the brackets [lower, upper] of the sample ranks,
+        * sorted by their lower rank, into disjoint pivots.
+        */
+        template <typename T, typename Key>
+        static void pivots(
+            const std::vector<T>& sample,
+            std::vector<std::size_t> ranks,
+            Key key,
+            std::vector<double>& lower,
+            std::vector<double>& upper)
+        {
+            // the distance, in sample ranks, between
+            // the quantile and the pivots
+            const std::size_t gap { static_cast<std::size_t>(3.0 * std::sqrt(static_cast<double>(sample_size))) };
+            const double infinity { std::numeric_limits<double>::infinity() };
+
+            std::sort(ranks.begin(), ranks.end());
+            for (std::size_t rank : ranks) {
+                const double first { rank < gap ? -infinity : key(sample[rank - gap]) };
+                const double last  { rank + gap >= sample_size ? infinity : key(sample[rank + gap]) };
+
+                if (!upper.empty() && first <= upper.back()) {
+                    upper.back() = std::max(upper.back(), last);
+                } else {
+                    lower.push_back(first);
+                    upper.push_back(last);
+                }
+            }
+        }
+
+        /**
+        * Collect the values between the pivots that bracket
+        * the order statistics in `ranks` in one parallel pass.
+        *
+        * @return true if the segments hold the order statistics.
+        */
+        template <typename Value>
+        static bool bracket(
+            Value value,
+            std::size_t n,
+            const std::vector<std::size_t>& ranks,
+            std::vector<Segment<double>>& segments)
+        {
+            // 1) the pivots around the
+            //    ranks in the sample
+            std::vector<double> sample;
+            sample.reserve(sample_size);
+            for (std::size_t i : draw(n)) sample.push_back(value(i));
+            std::sort(sample.begin(), sample.end());
+
+            const double scale { static_cast<double>(sample_size) / static_cast<double>(n) };
+            std::vector<std::size_t> sample_ranks;
+            for (std::size_t rank : ranks) sample_ranks.push_back(static_cast<std::size_t>(static_cast<double>(rank) * scale));
+
+            std::vector<double> lower, upper;
+            pivots(sample, sample_ranks, [](double x) { return x; }, lower, upper);
+
+            // 2) count the values between and
+            //    collect the values inside the
+            //    segments in one pass
+            const std::size_t k { lower.size() };
+            std::vector<std::size_t> between(k, 0);
+            segments.assign(k, Segment<double> {});
+
+            #ifdef _OPENMP
+                #pragma omp parallel if(getUseOpenMP())
+            #endif
+            {
+                std::vector<std::vector<double>> local(k);
+                std::vector<std::size_t> local_between(k, 0);
+
+                #ifdef _OPENMP
+                    #pragma omp for schedule(static) nowait
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    const double x { value(i) };
+                    const std::size_t j = std::lower_bound(upper.begin(), upper.end(), x) - upper.begin();
+
+                    if (j == k) continue;
+
+                    if (x < lower[j]) {
+                        local_between[j]++;
+                    } else {
+                        local[j].push_back(x);
+                    }
+                }
+
+                #ifdef _OPENMP
+                    #pragma omp critical
+                #endif
+                {
+                    for (std::size_t j = 0; j < k; j++) {
+                        between[j] += local_between[j];
+                        segments[j].values.insert(segments[j].values.end(), local[j].begin(), local[j].end());
+                    }
+                }
+            }
+
+            // 3) the rows below each segment, and
+            //    each order statistic must be inside
+            //    a segment
+            std::size_t below = 0;
+            for (std::size_t j = 0; j < k; j++) {
+                below += between[j];
+                segments[j].count_below = below;
+                below += segments[j].values.size();
+            }
+
+            for (std::size_t rank : ranks) {
+                const bool inside = std::any_of(segments.begin(), segments.end(), [rank](const Segment<double>& segment) {
+                    return segment.count_below <= rank && rank < segment.count_below + segment.values.size();
+                });
+
+                if (!inside) return false;
+            }
+
+            return true;
+        }
+
+        /**
+        * Collect the observations between the pivots that bracket
+        * the weighted quantiles in one parallel pass; `total` is set
+        * to the sum of the weights.
+        *
+        * @return true if the segments hold the quantiles.
+        */
+        template <typename Value, typename Weight>
+        static bool bracket(
+            Value value,
+            Weight weight,
+            std::size_t n,
+            const std::vector<double>& alpha,
+            std::vector<Segment<Observation>>& segments,
+            double& total)
+        {
+            // 1) the pivots around the weighted
+            //    quantiles of the sample
+            std::vector<Observation> sample;
+            sample.reserve(sample_size);
+            for (std::size_t i : draw(n)) sample.push_back(Observation { value(i), weight(i) });
+            std::sort(sample.begin(), sample.end(), [](const Observation& x, const Observation& y) { return x.value < y.value; });
+
+            std::vector<double> cumulative(sample_size);
+            double sum = 0.0;
+            for (std::size_t i = 0; i < sample_size; i++) cumulative[i] = (sum += sample[i].weight);
+
+            std::vector<std::size_t> sample_ranks;
+            for (double a : alpha) {
+                const std::size_t rank = std::lower_bound(cumulative.begin(), cumulative.end(), a * sum) - cumulative.begin();
+                sample_ranks.push_back(std::min(rank, sample_size - 1));
+            }
+
+            std::vector<double> lower, upper;
+            pivots(sample, sample_ranks, [](const Observation& o) { return o.value; }, lower, upper);
+
+            // 2) the rows and the weights between
+            //    and inside the segments in one pass
+            const std::size_t k { lower.size() };
+            std::vector<std::size_t> between(k, 0);
+            std::vector<double> weight_between(k, 0.0);
+            segments.assign(k, Segment<Observation> {});
+            total = 0.0;
+
+            #ifdef _OPENMP
+                #pragma omp parallel if(getUseOpenMP())
+            #endif
+            {
+                std::vector<std::vector<Observation>> local(k);
+                std::vector<std::size_t> local_between(k, 0);
+                std::vector<double> local_weight_between(k, 0.0), local_weight_inside(k, 0.0);
+                double local_total = 0.0;
+
+                #ifdef _OPENMP
+                    #pragma omp for schedule(static) nowait
+                #endif
+                for (std::size_t i = 0; i < n; i++) {
+                    const double x { value(i) };
+                    const double w { weight(i) };
+                    const std::size_t j = std::lower_bound(upper.begin(), upper.end(), x) - upper.begin();
+
+                    local_total += w;
+
+                    if (j == k) continue;
+
+                    if (x < lower[j]) {
+                        local_between[j]++;
+                        local_weight_between[j] += w;
+                    } else {
+                        local[j].push_back(Observation { x, w });
+                        local_weight_inside[j] += w;
+                    }
+                }
+
+                #ifdef _OPENMP
+                    #pragma omp critical
+                #endif
+                {
+                    total += local_total;
+                    for (std::size_t j = 0; j < k; j++) {
+                        between[j]               += local_between[j];
+                        weight_between[j]        += local_weight_between[j];
+                        segments[j].weight_inside += local_weight_inside[j];
+                        segments[j].values.insert(segments[j].values.end(), local[j].begin(), local[j].end());
+                    }
+                }
+            }
+
+            // 3) the rows and the weight below each
+            //    segment, and each quantile must be
+            //    inside a segment
+            std::size_t below = 0;
+            double weight_below = 0.0;
+            for (std::size_t j = 0; j < k; j++) {
+                below        += between[j];
+                weight_below += weight_between[j];
+
+                segments[j].count_below  = below;
+                segments[j].weight_below = weight_below;
+
+                below        += segments[j].values.size();
+                weight_below += segments[j].weight_inside;
+            }
+
+            for (double a : alpha) {
+                if (locate(segments, n, a * total) == segments.size()) return false;
+            }
+
+            return true;
+        }
+
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        Quantile()  = delete;
+        ~Quantile() = delete;
+};
+
+#endif
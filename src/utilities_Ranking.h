@@ -0,0 +1,441 @@
+#ifndef UTILITIES_RANKING_H
+#define UTILITIES_RANKING_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <algorithm>
+#include <numeric>
+#include <cstddef>
+#include <utility>
+#include <cmath>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "utilities_Package.h"
+#include "utilities_Sorting.h"
+
+/**
+ * @class Ranking
+ * @brief Column-wise descending orderings of a n x k response matrix.
+ *
+ * The ranking is the sort that every ROC, precision-recall and AUC
+ * calculation starts with. It is either computed here (one column per thread),
+ * or adopted from a <ranking>-object created in R, in which case no sorting
+ * takes place at all.
+ *
+ * The <ranking>-object is a list with the following elements:
+ *   - order:  n x k integer matrix of (1-based) row indices in descending order of each column.
+ *   - actual: (optional) n x k integer matrix with actual[order[, c]] in column c.
+ *   - w:      (optional) n x k numeric matrix with w[order[, c]] in column c.
+ *
+ * The permuted labels and weights turn the scans into sequential reads.
+ * An index matrix from preorder(response, decreasing = TRUE) is adopted as
+ * the `order` of a <ranking>-object without the cached values.
+ */
+class Ranking {
+    public:
+        /**
+        * Rank each column of the response matrix in descending order.
+        *
+        * @param response  Numeric matrix of predicted scores.
+        * @param presorted Set to true if each column in `response` is already sorted in descending order.
+        */
+        Ranking(
+            const Rcpp::NumericMatrix& response,
+            bool presorted = false)
+            : n_(response.nrow()),
+              k_(response.ncol()),
+              base_(0),
+              order_(n_ * k_),
+              ptr_order_(order_.data()),
+              ptr_labels_(nullptr),
+              ptr_weights_(nullptr)
+        {
+            sort_columns(response.begin(), order_.data(), n_, k_, presorted);
+        }
+
+        /**
+        * Adopt a <ranking>-object created in R.
+        *
+        * The cached labels and weights are only used if they were created from
+        * `actual` and `weights`, so a ranking can be reused with other labels or
+        * weights, eg. bootstrap replicates passed as weights.
+        *
+        * @param ranking   A list with an `order` matrix and, optionally, the permuted `actual` and `w` matrices.
+        * @param response  Numeric matrix of predicted scores the ranking was created from.
+        * @param actual    Optional pointer to the actual classes of the call.
+        * @param weights   Optional pointer to the weights of the call.
+        */
+        Ranking(
+            const Rcpp::List& ranking,
+            const Rcpp::NumericMatrix& response,
+            const Rcpp::IntegerVector* actual = nullptr,
+            const Rcpp::NumericVector* weights = nullptr)
+            : n_(response.nrow()),
+              k_(response.ncol()),
+              base_(1),
+              ptr_labels_(nullptr),
+              ptr_weights_(nullptr)
+        {
+            // 1) the ordering itself
+            adopt_order(Rcpp::as<Rcpp::IntegerMatrix>(ranking["order"]), response);
+
+            // 2) the (optional) permuted labels
+            //    and weights
+            if (ranking.containsElementNamed("actual") && !Rf_isNull(ranking["actual"])) {
+                labels_matrix_ = Rcpp::as<Rcpp::IntegerMatrix>(ranking["actual"]);
+                check_dimensions(labels_matrix_.nrow(), labels_matrix_.ncol(), "actual");
+                ptr_labels_ = labels_matrix_.begin();
+            }
+
+            if (ranking.containsElementNamed("w") && !Rf_isNull(ranking["w"])) {
+                weights_matrix_ = Rcpp::as<Rcpp::NumericMatrix>(ranking["w"]);
+                check_dimensions(weights_matrix_.nrow(), weights_matrix_.ncol(), "w");
+                ptr_weights_ = weights_matrix_.begin();
+            }
+
+            // 3) drop the cached values that do not
+            //    belong to the call; the scans then read
+            //    through the ordering instead
+            if (ptr_labels_ != nullptr && actual != nullptr && !cached(ptr_labels_, actual->begin())) {
+                ptr_labels_ = nullptr;
+            }
+
+            if (ptr_weights_ != nullptr && weights != nullptr && !cached(ptr_weights_, weights->begin())) {
+                ptr_weights_ = nullptr;
+            }
+        }
+
+        /**
+        * Adopt an index matrix created by preorder(response, decreasing = TRUE).
+        *
+        * @param order     n x k integer matrix of (1-based) row indices in descending order of each column.
+        * @param response  Numeric matrix of predicted scores the ordering was created from.
+        */
+        Ranking(
+            const Rcpp::IntegerMatrix& order,
+            const Rcpp::NumericMatrix& response)
+            : n_(response.nrow()),
+              k_(response.ncol()),
+              base_(1),
+              ptr_labels_(nullptr),
+              ptr_weights_(nullptr)
+        {
+            adopt_order(order, response);
+        }
+
+        /**
+        * Adopt a ranking passed from R; either a <ranking>-object
+        * or an index matrix created by preorder().
+        *
+        * @param ranking   A <ranking>-object or an integer matrix.
+        * @param response  Numeric matrix of predicted scores the ranking was created from.
+        * @param actual    Optional pointer to the actual classes of the call.
+        * @param weights   Optional pointer to the weights of the call.
+        */
+        static Ranking adopt(
+            const Rcpp::RObject& ranking,
+            const Rcpp::NumericMatrix& response,
+            const Rcpp::IntegerVector* actual = nullptr,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            if (Rcpp::is<Rcpp::IntegerMatrix>(ranking)) {
+                return Ranking(Rcpp::as<Rcpp::IntegerMatrix>(ranking), response);
+            }
+
+            if (!Rcpp::is<Rcpp::List>(ranking)) {
+                Rcpp::stop("The `ranking` must be a <ranking>-object or an integer matrix created by preorder().");
+            }
+
+            return Ranking(Rcpp::as<Rcpp::List>(ranking), response, actual, weights);
+        }
+
+        // the ordering is referenced by pointer
+        // so the ranking can be moved, but not copied
+        Ranking(const Ranking&) = delete;
+        Ranking& operator=(const Ranking&) = delete;
+        Ranking(Ranking&&) = default;
+
+        /**
+        * @return The row index (0-based) of the i'th highest score in column c.
+        */
+        inline std::size_t row(std::size_t i, std::size_t c) const {
+            return static_cast<std::size_t>(ptr_order_[c * n_ + i] - base_);
+        }
+
+        /**
+        * @return The class label of the i'th highest score in column c.
+        */
+        inline int label(const int* ptr_actual, std::size_t i, std::size_t c) const {
+            return (ptr_labels_ != nullptr) ? ptr_labels_[c * n_ + i] : ptr_actual[row(i, c)];
+        }
+
+        /**
+        * @return The weight of the i'th highest score in column c.
+        *
+        * NOTE: the cached weights are only used for weighted
+        * calculations, ie. when ptr_weights is not a nullptr.
+        */
+        inline double weight(const double* ptr_weights, std::size_t i, std::size_t c) const {
+            if (ptr_weights == nullptr) return 1.0;
+            return (ptr_weights_ != nullptr) ? ptr_weights_[c * n_ + i] : ptr_weights[row(i, c)];
+        }
+
+        /**
+        * @return The weight of the i'th highest score in column c,
+        *         with the check for weights resolved at compile time.
+        *
+        * NOTE: used by the scans that are specialized on
+        * weightedness, so the unweighted loops carry no branch.
+        */
+        template <bool weighted>
+        inline double weight(const double* ptr_weights, std::size_t i, std::size_t c) const {
+            if constexpr (weighted) {
+                return (ptr_weights_ != nullptr) ? ptr_weights_[c * n_ + i] : ptr_weights[row(i, c)];
+            } else {
+                return 1.0;
+            }
+        }
+
+        /**
+        * @return The rank of the first score in column c that is below `threshold`,
+        *         searched from rank `first` onwards.
+        *
+        * NOTE: a galloping search from `first`, so a sweep over m
+        * thresholds in descending order reads O(m log(n / m)) scores
+        * instead of all n.
+        */
+        inline std::size_t lower_rank(const double* col_ptr, std::size_t c, std::size_t first, double threshold) const {
+            // 1) gallop until the score
+            //    drops below the threshold
+            std::size_t lower { first };
+            std::size_t upper { first };
+            std::size_t step { 1 };
+            while (upper < n_ && col_ptr[row(upper, c)] >= threshold) {
+                lower = upper + 1;
+                upper = first + step;
+                step *= 2;
+            }
+            upper = std::min(upper, n_);
+
+            // 2) binary search within
+            //    the last step
+            while (lower < upper) {
+                const std::size_t mid { lower + (upper - lower) / 2 };
+                if (col_ptr[row(mid, c)] >= threshold) {
+                    lower = mid + 1;
+                } else {
+                    upper = mid;
+                }
+            }
+
+            return lower;
+        }
+
+        inline std::size_t nrow() const { return n_; }
+        inline std::size_t ncol() const { return k_; }
+
+        /**
+        * Order user-specified thresholds in descending order.
+        *
+        * The curves are scanned from the highest threshold down, so
+        * the thresholds are sorted once and each point is written back
+        * to the position of its threshold.
+        *
+        * @param thresholds Numeric vector of thresholds in any order.
+        * @return           The (0-based) positions of the thresholds in descending order; ties keep their order.
+        */
+        static std::vector<std::size_t> threshold_order(const Rcpp::NumericVector& thresholds) {
+            const double* ptr_thresholds { thresholds.begin() };
+            const std::size_t m { static_cast<std::size_t>(thresholds.size()) };
+
+            for (std::size_t k = 0; k < m; k++) {
+                if (std::isnan(ptr_thresholds[k])) {
+                    Rcpp::stop("The `thresholds` must not contain missing values.");
+                }
+            }
+
+            std::vector<std::size_t> order(m);
+            std::iota(order.begin(), order.end(), 0);
+            std::stable_sort(order.begin(), order.end(), [ptr_thresholds](std::size_t a, std::size_t b) {
+                return ptr_thresholds[a] > ptr_thresholds[b];
+            });
+
+            return order;
+        }
+
+        /**
+        * Create the <ranking>-object returned to R.
+        *
+        * @param response Numeric matrix of predicted scores.
+        * @param actual   Optional pointer to the actual classes; stored in ranked order if passed.
+        * @param weights  Optional pointer to the weights; stored in ranked order if passed.
+        */
+        static Rcpp::List create(
+            const Rcpp::NumericMatrix& response,
+            const Rcpp::IntegerVector* actual = nullptr,
+            const Rcpp::NumericVector* weights = nullptr)
+        {
+            // 0) variable declarations
+            const std::size_t n { static_cast<std::size_t>(response.nrow()) };
+            const std::size_t k { static_cast<std::size_t>(response.ncol()) };
+
+            Rcpp::IntegerMatrix order(n, k);
+            Rcpp::IntegerMatrix labels { (actual != nullptr) ? Rcpp::IntegerMatrix(n, k) : Rcpp::IntegerMatrix(0, 0) };
+            Rcpp::NumericMatrix weight { (weights != nullptr) ? Rcpp::NumericMatrix(n, k) : Rcpp::NumericMatrix(0, 0) };
+
+            int* ptr_order { order.begin() };
+            int* ptr_labels { labels.begin() };
+            double* ptr_weight { weight.begin() };
+            const int* ptr_actual { (actual != nullptr) ? actual->begin() : nullptr };
+            const double* ptr_weights { (weights != nullptr) ? weights->begin() : nullptr };
+
+            if (actual != nullptr && static_cast<std::size_t>(actual->size()) != n) {
+                Rcpp::stop("The length of `actual` (%d) does not match the rows of `response` (%d).", static_cast<int>(actual->size()), static_cast<int>(n));
+            }
+
+            if (weights != nullptr && static_cast<std::size_t>(weights->size()) != n) {
+                Rcpp::stop("The length of `w` (%d) does not match the rows of `response` (%d).", static_cast<int>(weights->size()), static_cast<int>(n));
+            }
+
+            // 1) sort each column
+            sort_columns(response.begin(), ptr_order, n, k, false);
+
+            // 2) permute the labels and weights
+            //    and convert to 1-based indices
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < k; c++) {
+                int* col_order { ptr_order + c * n };
+
+                for (std::size_t i = 0; i < n; i++) {
+                    if (ptr_actual != nullptr) ptr_labels[c * n + i] = ptr_actual[col_order[i]];
+                    if (ptr_weights != nullptr) ptr_weight[c * n + i] = ptr_weights[col_order[i]];
+                    col_order[i] += 1;
+                }
+            }
+
+            // 3) construct the list
+            Rcpp::List output = Rcpp::List::create(
+                Rcpp::Named("order")  = order,
+                Rcpp::Named("actual") = (actual != nullptr) ? Rcpp::RObject(labels) : Rcpp::RObject(R_NilValue),
+                Rcpp::Named("w")      = (weights != nullptr) ? Rcpp::RObject(weight) : Rcpp::RObject(R_NilValue)
+            );
+            output.attr("class") = "ranking";
+
+            return output;
+        }
+
+    private:
+        std::size_t n_;
+        std::size_t k_;
+        int base_;
+
+        // owned ordering (if sorted here)
+        std::vector<int> order_;
+
+        // adopted R objects; kept as members
+        // so they stay protected
+        Rcpp::IntegerMatrix order_matrix_;
+        Rcpp::IntegerMatrix labels_matrix_;
+        Rcpp::NumericMatrix weights_matrix_;
+
+        const int* ptr_order_;
+        const int* ptr_labels_;
+        const double* ptr_weights_;
+
+        /**
+        * Sort the row indices of each column in descending order
+        * of the scores; one column per thread.
+        */
+        static void sort_columns(
+            const double* ptr_response,
+            int* ptr_order,
+            std::size_t n,
+            std::size_t k,
+            bool presorted)
+        {
+            if (!presorted) {
+                ColumnSort::order(ptr_response, ptr_order, n, k, true);
+                return;
+            }
+
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < k; c++) {
+                std::iota(ptr_order + c * n, ptr_order + (c + 1) * n, 0);
+            }
+        }
+
+        /**
+        * Adopt a (1-based) ordering; the indices are dereferenced
+        * without bounds checks in the scans, so each column must
+        * be a permutation of the rows in descending order of
+        * `response`. An ascending ordering, or the ranking of
+        * another response, would silently give wrong curves.
+        */
+        void adopt_order(const Rcpp::IntegerMatrix& order, const Rcpp::NumericMatrix& response) {
+            order_matrix_ = order;
+            check_dimensions(order_matrix_.nrow(), order_matrix_.ncol(), "order");
+            ptr_order_ = order_matrix_.begin();
+
+            const int upper { static_cast<int>(n_) };
+            const double* ptr_response { response.begin() };
+            std::vector<unsigned char> seen(n_);
+            for (std::size_t c = 0; c < k_; c++) {
+                std::fill(seen.begin(), seen.end(), 0);
+
+                const double* col_ptr { ptr_response + c * n_ };
+                double previous { 0.0 };
+                for (std::size_t i = 0; i < n_; i++) {
+                    const int index { ptr_order_[c * n_ + i] };
+                    if (index < 1 || index > upper) {
+                        Rcpp::stop("The `order` in the ranking contains indices outside of 1 to %d.", upper);
+                    }
+
+                    if (seen[index - 1]) {
+                        Rcpp::stop("The `order` in the ranking must be a permutation of the rows; row %d is repeated.", index);
+                    }
+                    seen[index - 1] = 1;
+
+                    // NOTE: NaN compares false, so
+                    // missing scores are not rejected here
+                    const double score { col_ptr[index - 1] };
+                    if (i > 0 && score > previous) {
+                        Rcpp::stop("The `ranking` must be in descending order of `response`; use ranking(response) or preorder(response, decreasing = TRUE).");
+                    }
+                    previous = score;
+                }
+            }
+        }
+
+        /**
+        * @return True if the first column of the cached matrix is the
+        *         ranked `values`.
+        *
+        * NOTE: the ordering is a permutation, so the first column
+        * determines all of `values`; the remaining columns are
+        * permutations of the same values.
+        */
+        template <typename T>
+        bool cached(const T* ptr_cache, const T* ptr_values) const {
+            if (k_ == 0) return true;
+            for (std::size_t i = 0; i < n_; i++) {
+                if (ptr_cache[i] != ptr_values[row(i, 0)]) return false;
+            }
+
+            return true;
+        }
+
+        void check_dimensions(R_xlen_t nrow, R_xlen_t ncol, const char* element) const {
+            if (static_cast<std::size_t>(nrow) != n_ || static_cast<std::size_t>(ncol) != k_) {
+                Rcpp::stop("The dimensions of `%s` in the ranking does not match the response matrix.", element);
+            }
+        }
+};
+
+#endif
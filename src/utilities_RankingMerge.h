@@ -0,0 +1,134 @@
+#ifndef UTILITIES_RANKINGMERGE_H
+#define UTILITIES_RANKINGMERGE_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <cstddef>
+
+#include "utilities_Ranking.h"
+
+/**
+ * @class RankingMerge
+ * @brief A k-way merge of the columns of a Ranking in descending order of the scores.
+ *
+ * The micro average pools all n x k scores into one curve. Instead of
+ * flattening them into a container and sorting it, each column is sorted on
+ * its own (in parallel, by the Ranking) and the columns are merged
+ * through a binary heap of the k column heads. The merge needs O(k) memory
+ * on top of the ranking, and each entry costs O(log k).
+ *
+ * The heads are stored as a structure of arrays; the scores and positions of
+ * the heads are indexed by column, and the heap only holds column indices.
+ *
+ * Usage:
+ *
+ *   RankingMerge merge(response, ranking);
+ *   while (!merge.empty()) {
+ *       double score { merge.peek() };
+ *       merge.pop(row, column);
+ *   }
+ */
+class RankingMerge {
+    public:
+        /**
+        * @param response Numeric matrix of predicted scores.
+        * @param ranking  The column-wise descending ordering of `response`.
+        */
+        RankingMerge(
+            const Rcpp::NumericMatrix& response,
+            const Ranking& ranking)
+            : ranking_(ranking),
+              ptr_response_(response.begin()),
+              n_(ranking.nrow()),
+              position_(ranking.ncol(), 0),
+              score_(ranking.ncol())
+        {
+            // 1) the heads of the
+            // non-empty columns
+            heap_.reserve(ranking.ncol());
+            if (n_ == 0) return;
+
+            for (std::size_t c = 0; c < ranking.ncol(); c++) {
+                score_[c] = head_score(c);
+                heap_.push_back(c);
+            }
+
+            // 2) heapify
+            for (std::size_t i = heap_.size() / 2; i-- > 0; ) {
+                sift_down(i);
+            }
+        }
+
+        RankingMerge(const RankingMerge&) = delete;
+        RankingMerge& operator=(const RankingMerge&) = delete;
+
+        inline bool empty() const { return heap_.empty(); }
+
+        /**
+        * @return The highest remaining score.
+        */
+        inline double peek() const { return score_[heap_.front()]; }
+
+        /**
+        * Remove the highest remaining score.
+        *
+        * @param row    The row of the score in the response matrix.
+        * @param column The column of the score in the response matrix.
+        */
+        inline void pop(std::size_t& row, std::size_t& column) {
+            column = heap_.front();
+            row    = ranking_.row(position_[column], column);
+
+            // 1) advance the column; an exhausted
+            // column is replaced by the last leaf
+            if (++position_[column] < n_) {
+                score_[column] = head_score(column);
+            } else {
+                heap_.front() = heap_.back();
+                heap_.pop_back();
+            }
+
+            if (!heap_.empty()) sift_down(0);
+        }
+
+    private:
+        const Ranking& ranking_;
+        const double* ptr_response_;
+        std::size_t n_;
+
+        // the heads of each column
+        std::vector<std::size_t> position_;
+        std::vector<double> score_;
+
+        // max-heap of column indices
+        std::vector<std::size_t> heap_;
+
+        inline double head_score(std::size_t c) const {
+            return ptr_response_[c * n_ + ranking_.row(position_[c], c)];
+        }
+
+        // ties are broken by the column
+        // so the merge is deterministic
+        inline bool before(std::size_t a, std::size_t b) const {
+            return score_[a] > score_[b] || (score_[a] == score_[b] && a < b);
+        }
+
+        void sift_down(std::size_t i) {
+            const std::size_t size { heap_.size() };
+            const std::size_t column { heap_[i] };
+
+            for (;;) {
+                std::size_t child { 2 * i + 1 };
+                if (child >= size) break;
+                if (child + 1 < size && before(heap_[child + 1], heap_[child])) child++;
+                if (!before(heap_[child], column)) break;
+
+                heap_[i] = heap_[child];
+                i = child;
+            }
+
+            heap_[i] = column;
+        }
+};
+
+#endif
@@ -0,0 +1,168 @@
+#include "utilities_SIMD.h"
+
+#include <Rcpp.h>
+#include <cmath>
+#include <cstddef>
+
+using namespace Rcpp;
+
+#if defined(__GNUC__) && (defined(__x86_64__) || defined(__i386__))
+    #define SIMD_X86 1
+#else
+    #define SIMD_X86 0
+#endif
+
+/**
+ * @brief The scalar loops; the kernels
+ * without explicit vectorization.
+ */
+namespace scalar {
+
+    template <typename Loss>
+    double kernel(const double* actual, const double* predicted, const double* weights, std::size_t n, double& weight, Loss loss)
+    {
+        double sum = 0.0;
+
+        if (weights) {
+            double sum_w = 0.0;
+            for (std::size_t i = 0; i < n; ++i) {
+                sum   += weights[i] * loss(actual[i] - predicted[i]);
+                sum_w += weights[i];
+            }
+            weight += sum_w;
+        } else {
+            for (std::size_t i = 0; i < n; ++i) {
+                sum += loss(actual[i] - predicted[i]);
+            }
+            weight += static_cast<double>(n);
+        }
+
+        return sum;
+    }
+
+    double squared(const double* actual, const double* predicted, const double* weights, std::size_t n, double, double& weight)
+    {
+        return kernel(actual, predicted, weights, n, weight, [](double d) { return d * d; });
+    }
+
+    double absolute(const double* actual, const double* predicted, const double* weights, std::size_t n, double, double& weight)
+    {
+        return kernel(actual, predicted, weights, n, weight, [](double d) { return std::fabs(d); });
+    }
+
+    double huber(const double* actual, const double* predicted, const double* weights, std::size_t n, double delta, double& weight)
+    {
+        return kernel(actual, predicted, weights, n, weight, [delta](double d) {
+            const double abs_d { std::fabs(d) };
+            return abs_d <= delta ? 0.5 * d * d : delta * (abs_d - 0.5 * delta);
+        });
+    }
+
+    double pinball(const double* actual, const double* predicted, const double* weights, std::size_t n, double alpha, double& weight)
+    {
+        return kernel(actual, predicted, weights, n, weight, [alpha](double d) {
+            return d >= 0.0 ? alpha * d : (1.0 - alpha) * (-d);
+        });
+    }
+
+}
+
+// 1) the baseline; SSE2 on x86-64
+//    and the native width elsewhere
+namespace baseline {
+    #define SIMD_LANES 2
+    #include "utilities_SIMDKernels.h"
+    #undef SIMD_LANES
+}
+
+#if SIMD_X86
+
+// 2) AVX2
+#if defined(__clang__)
+    #pragma clang attribute push (__attribute__((target("avx2"))), apply_to = function)
+#else
+    #pragma GCC push_options
+    #pragma GCC target("avx2")
+#endif
+
+namespace avx2 {
+    #define SIMD_LANES 4
+    #include "utilities_SIMDKernels.h"
+    #undef SIMD_LANES
+}
+
+#if defined(__clang__)
+    #pragma clang attribute pop
+#else
+    #pragma GCC pop_options
+#endif
+
+// 3) AVX-512
+#if defined(__clang__)
+    #pragma clang attribute push (__attribute__((target("avx512f"))), apply_to = function)
+#else
+    #pragma GCC push_options
+    #pragma GCC target("avx512f")
+#endif
+
+namespace avx512 {
+    #define SIMD_LANES 8
+    #include "utilities_SIMDKernels.h"
+    #undef SIMD_LANES
+}
+
+#if defined(__clang__)
+    #pragma clang attribute pop
+#else
+    #pragma GCC pop_options
+#endif
+
+#endif
+
+namespace {
+
+    /**
+     * @brief select the kernels of the best
+     * instruction set supported by the CPU.
+     */
+    SIMD::kernel_table select_kernels() {
+        #if SIMD_X86
+            __builtin_cpu_init();
+
+            if (__builtin_cpu_supports("avx512f")) {
+                return { avx512::squared, avx512::absolute, avx512::huber, avx512::pinball, "avx512" };
+            }
+
+            if (__builtin_cpu_supports("avx2")) {
+                return { avx2::squared, avx2::absolute, avx2::huber, avx2::pinball, "avx2" };
+            }
+
+            return { baseline::squared, baseline::absolute, baseline::huber, baseline::pinball, "sse2" };
+        #else
+            return { baseline::squared, baseline::absolute, baseline::huber, baseline::pinball, "baseline" };
+        #endif
+    }
+
+    // the kernels are selected
+    // when the package is loaded
+    const SIMD::kernel_table vectorized_kernels = select_kernels();
+    const SIMD::kernel_table scalar_kernels     = { scalar::squared, scalar::absolute, scalar::huber, scalar::pinball, "scalar" };
+
+    bool use_simd_flag = true;
+
+}
+
+const SIMD::kernel_table& SIMD::kernels() {
+    return use_simd_flag ? vectorized_kernels : scalar_kernels;
+}
+
+// [[Rcpp::export(.simd_isa)]]
+std::string simd_isa() {
+    return SIMD::kernels().isa;
+}
+
+// [[Rcpp::export(.use_simd)]]
+std::string use_simd(bool value = true) {
+    use_simd_flag = value;
+    return SIMD::kernels().isa;
+}
@@ -0,0 +1,101 @@
+#ifndef UTILITIES_SIMD_H
+#define UTILITIES_SIMD_H
+
+#include "utilities_Package.h"
+#include <algorithm>
+#include <cstddef>
+
+#ifdef _OPENMP
+    #include <omp.h>
+#endif
+
+/**
+ * @class SIMD
+ * @brief Vectorized reductions of the regression losses.
+ *
+ * The kernels are compiled once per instruction set (SSE2, AVX2 and
+ * AVX-512 on x86, and the baseline elsewhere), and the best set
+ * supported by the CPU is selected when the package is loaded; see
+ * utilities_SIMD.cpp. The kernels can be switched back to the scalar
+ * loops with .use_simd(FALSE), which is used for benchmarking.
+ *
+ * Each kernel returns the (weighted) sum of a loss of d = a - p over
+ * a block of rows, and adds the sum of the weights, or the number of
+ * rows if unweighted, to `weight`.
+ */
+class SIMD {
+    public:
+        typedef double (*kernel_type)(
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            double parameter,
+            double& weight
+        );
+
+        struct kernel_table {
+            kernel_type squared;   // d^2
+            kernel_type absolute;  // |d|
+            kernel_type huber;     // huber(d); the parameter is delta
+            kernel_type pinball;   // pinball(d); the parameter is alpha
+            const char* isa;
+        };
+
+        // the kernels selected
+        // at load time
+        static const kernel_table& kernels();
+
+        /**
+        * Reduce the rows in parallel blocks.
+        *
+        * @param kernel    The kernel of the loss.
+        * @param actual    Pointer to actual values.
+        * @param predicted Pointer to predicted values.
+        * @param weights   Pointer to weights; nullptr if unweighted.
+        * @param n         Number of observations.
+        * @param parameter The parameter of the loss.
+        * @param weight    Set to the sum of the weights, or n if unweighted.
+        * @return          The (weighted) sum of the loss.
+        */
+        static double reduce(
+            kernel_type kernel,
+            const double* actual,
+            const double* predicted,
+            const double* weights,
+            std::size_t n,
+            double parameter,
+            double& weight)
+        {
+            const std::size_t n_blocks { (n + block_size - 1) / block_size };
+
+            double sum   = 0.0;
+            double sum_w = 0.0;
+
+            #ifdef _OPENMP
+                #pragma omp parallel for reduction(+:sum, sum_w) schedule(static) if(getUseOpenMP())
+            #endif
+            for (std::size_t b = 0; b < n_blocks; b++) {
+                const std::size_t first { b * block_size };
+                const std::size_t last  { std::min(n, first + block_size) };
+
+                sum += kernel(actual + first, predicted + first, weights ? weights + first : nullptr, last - first, parameter, sum_w);
+            }
+
+            weight = sum_w;
+
+            return sum;
+        }
+
+    private:
+        // rows per block
+        static constexpr std::size_t block_size = 4096;
+
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        SIMD()  = delete;
+        ~SIMD() = delete;
+};
+
+#endif
@@ -0,0 +1,183 @@
+// NOTE: This file has no include guard. It is included
+// once per instruction set by utilities_SIMD.cpp, inside the
+// namespace and the target region of the instruction set, and
+// with SIMD_LANES set to the number of doubles per register.
+//
+// The kernels use the vector extensions of GCC and Clang, so the
+// arithmetic is explicitly vectorized for the instruction set of the
+// region, and the loops keep four independent accumulators to hide
+// the latency of the additions.
+
+typedef double    vector_type __attribute__((vector_size(SIMD_LANES * sizeof(double))));
+typedef long long mask_type   __attribute__((vector_size(SIMD_LANES * sizeof(double))));
+
+inline vector_type load(const double* x)
+{
+    vector_type value;
+    __builtin_memcpy(&value, x, sizeof(value));
+    return value;
+}
+
+template <typename T>
+inline T broadcast(double x)
+{
+    return T{} + x;
+}
+
+inline double select(bool mask, double x, double y)
+{
+    return mask ? x : y;
+}
+
+inline vector_type select(mask_type mask, vector_type x, vector_type y)
+{
+    return (vector_type)(((mask_type)x & mask) | ((mask_type)y & ~mask));
+}
+
+inline double absolute(double x)
+{
+    return x < 0.0 ? -x : x;
+}
+
+inline vector_type absolute(vector_type x)
+{
+    return select(x < vector_type{}, -x, x);
+}
+
+// the losses of the
+// difference d = a - p
+struct Squared {
+    double parameter;
+
+    template <typename T>
+    T operator()(T d) const { return d * d; }
+};
+
+struct Absolute {
+    double parameter;
+
+    template <typename T>
+    T operator()(T d) const { return absolute(d); }
+};
+
+struct Huber {
+    double parameter;  // delta
+
+    template <typename T>
+    T operator()(T d) const {
+        const T delta { broadcast<T>(parameter) };
+        const T abs_d { absolute(d) };
+        return select(abs_d <= delta, broadcast<T>(0.5) * d * d, delta * (abs_d - broadcast<T>(0.5) * delta));
+    }
+};
+
+struct Pinball {
+    double parameter;  // alpha
+
+    template <typename T>
+    T operator()(T d) const {
+        return select(d < T{}, broadcast<T>(parameter - 1.0) * d, broadcast<T>(parameter) * d);
+    }
+};
+
+/**
+ * @brief The (weighted) sum of the losses of a - p; the sum of the weights is added to `weight`.
+ */
+template <bool weighted, typename Loss>
+inline double reduce(
+    const double* actual,
+    const double* predicted,
+    const double* weights,
+    std::size_t n,
+    double& weight,
+    const Loss& loss)
+{
+    constexpr std::size_t lanes { SIMD_LANES };
+    constexpr std::size_t step  { 4 * lanes };
+
+    vector_type sum_0 {}, sum_1 {}, sum_2 {}, sum_3 {};
+    vector_type w_0 {}, w_1 {}, w_2 {}, w_3 {};
+
+    // 1) the vectorized body with
+    //    four independent accumulators
+    std::size_t i = 0;
+    for (; i + step <= n; i += step) {
+        const vector_type d_0 { load(actual + i)             - load(predicted + i) };
+        const vector_type d_1 { load(actual + i + lanes)     - load(predicted + i + lanes) };
+        const vector_type d_2 { load(actual + i + 2 * lanes) - load(predicted + i + 2 * lanes) };
+        const vector_type d_3 { load(actual + i + 3 * lanes) - load(predicted + i + 3 * lanes) };
+
+        if constexpr (weighted) {
+            const vector_type v_0 { load(weights + i) };
+            const vector_type v_1 { load(weights + i + lanes) };
+            const vector_type v_2 { load(weights + i + 2 * lanes) };
+            const vector_type v_3 { load(weights + i + 3 * lanes) };
+
+            sum_0 += v_0 * loss(d_0); w_0 += v_0;
+            sum_1 += v_1 * loss(d_1); w_1 += v_1;
+            sum_2 += v_2 * loss(d_2); w_2 += v_2;
+            sum_3 += v_3 * loss(d_3); w_3 += v_3;
+        } else {
+            sum_0 += loss(d_0);
+            sum_1 += loss(d_1);
+            sum_2 += loss(d_2);
+            sum_3 += loss(d_3);
+        }
+    }
+
+    // 2) the horizontal sums
+    const vector_type sum_vector    { (sum_0 + sum_1) + (sum_2 + sum_3) };
+    const vector_type weight_vector { (w_0 + w_1) + (w_2 + w_3) };
+
+    double sum = 0.0, sum_w = 0.0;
+    for (std::size_t j = 0; j < lanes; j++) {
+        sum   += sum_vector[j];
+        sum_w += weight_vector[j];
+    }
+
+    // 3) the scalar tail
+    for (; i < n; i++) {
+        const double d { actual[i] - predicted[i] };
+
+        if constexpr (weighted) {
+            sum   += weights[i] * loss(d);
+            sum_w += weights[i];
+        } else {
+            sum += loss(d);
+        }
+    }
+
+    weight += weighted ? sum_w : static_cast<double>(n);
+
+    return sum;
+}
+
+template <typename Loss>
+inline double kernel(const double* actual, const double* predicted, const double* weights, std::size_t n, double parameter, double& weight)
+{
+    if (weights) {
+        return reduce<true>(actual, predicted, weights, n, weight, Loss { parameter });
+    }
+
+    return reduce<false>(actual, predicted, weights, n, weight, Loss { parameter });
+}
+
+double squared(const double* actual, const double* predicted, const double* weights, std::size_t n, double parameter, double& weight)
+{
+    return kernel<Squared>(actual, predicted, weights, n, parameter, weight);
+}
+
+double absolute(const double* actual, const double* predicted, const double* weights, std::size_t n, double parameter, double& weight)
+{
+    return kernel<Absolute>(actual, predicted, weights, n, parameter, weight);
+}
+
+double huber(const double* actual, const double* predicted, const double* weights, std::size_t n, double parameter, double& weight)
+{
+    return kernel<Huber>(actual, predicted, weights, n, parameter, weight);
+}
+
+double pinball(const double* actual, const double* predicted, const double* weights, std::size_t n, double parameter, double& weight)
+{
+    return kernel<Pinball>(actual, predicted, weights, n, parameter, weight);
+}
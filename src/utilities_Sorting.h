@@ -0,0 +1,130 @@
+#ifndef UTILITIES_SORTING_H
+#define UTILITIES_SORTING_H
+
+#include <Rcpp.h>
+#include <vector>
+#include <algorithm>
+#include <functional>
+#include <cstddef>
+#include <utility>
+
+#ifdef _OPENMP
+  #include <omp.h>
+#endif
+
+#include "utilities_Package.h"
+
+/**
+ * @class ColumnSort
+ * @brief Column-wise sorting and ordering of a n x k matrix.
+ *
+ * The columns are independent, so they are distributed over the
+ * OpenMP threads; each thread owns the buffer of the column it sorts.
+ * The input is only read, and the result is written to `out`, which
+ * can be the input itself for an in-place sort.
+ *
+ * The orderings sort the scores alongside the indices, so the comparisons
+ * read contiguous memory instead of dereferencing the indices.
+ */
+class ColumnSort {
+    public:
+        /**
+        * Sort each column of `x` into `out`.
+        *
+        * @param x          Pointer to the n x k matrix to sort.
+        * @param out        Pointer to the n x k output; may be equal to `x`.
+        * @param n          The number of rows.
+        * @param k          The number of columns.
+        * @param decreasing Set to true to sort in descending order.
+        */
+        static void sort(
+            const double* x,
+            double* out,
+            std::size_t n,
+            std::size_t k,
+            bool decreasing = false)
+        {
+            #ifdef _OPENMP
+                #pragma omp parallel for if(getUseOpenMP())
+            #endif
+            for (std::size_t c = 0; c < k; c++) {
+                double* first { out + c * n };
+
+                // 1) copy the column unless
+                //    the sort is in-place
+                if (first != x + c * n) {
+                    std::copy(x + c * n, x + (c + 1) * n, first);
+                }
+
+                // 2) sort the column
+                if (decreasing) {
+                    std::sort(first, first + n, std::greater<double>());
+                } else {
+                    std::sort(first, first + n);
+                }
+            }
+        }
+
+        /**
+        * Order each column of `x` into `out`.
+        *
+        * @param x          Pointer to the n x k matrix to order.
+        * @param out        Pointer to the n x k output of row indices.
+        * @param n          The number of rows.
+        * @param k          The number of columns.
+        * @param decreasing Set to true to order in descending order.
+        * @param base       The index of the first row; 0 for C++, and 1 for R.
+        */
+        static void order(
+            const double* x,
+            int* out,
+            std::size_t n,
+            std::size_t k,
+            bool decreasing = false,
+            int base = 0)
+        {
+            #ifdef _OPENMP
+                #pragma omp parallel if(getUseOpenMP())
+            #endif
+            {
+                // the (score, index)-buffer
+                // is allocated once per thread
+                std::vector<std::pair<double, int>> buffer(k > 0 ? n : 0);
+
+                #ifdef _OPENMP
+                    #pragma omp for
+                #endif
+                for (std::size_t c = 0; c < k; c++) {
+                    const double* col_ptr { x + c * n };
+                    int* first { out + c * n };
+
+                    for (std::size_t i = 0; i < n; i++) {
+                        buffer[i] = { col_ptr[i], static_cast<int>(i) };
+                    }
+
+                    if (decreasing) {
+                        std::sort(buffer.begin(), buffer.end(), [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+                            return a.first > b.first;
+                        });
+                    } else {
+                        std::sort(buffer.begin(), buffer.end(), [](const std::pair<double, int>& a, const std::pair<double, int>& b) {
+                            return a.first < b.first;
+                        });
+                    }
+
+                    for (std::size_t i = 0; i < n; i++) {
+                        first[i] = buffer[i].second + base;
+                    }
+                }
+            }
+        }
+
+    private:
+        // delete class
+        // to avoid mischiefs
+        // from compiler
+        ColumnSort()  = delete;
+        ~ColumnSort() = delete;
+};
+
+#endif